@@ -11,6 +11,8 @@
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cstdlib>
+#include <future>
 #include <utility>
 #include <limits>
 #include "../core_engine/Stock.h"
@@ -24,20 +26,43 @@ AuthenticationManager::AuthenticationManager(const std::string& redis_host, int
         std::cerr << "Failed to create Redis client: " << e.what() << std::endl;
         redis_client_ = nullptr;
     }
+
+    if (const char* ttl_env = std::getenv("AUREX_AUTH_CACHE_TTL_SEC")) {
+        int ttl = std::atoi(ttl_env);
+        if (ttl > 0) {
+            auth_cache_ttl_sec_ = ttl;
+        }
+    }
 }
 
-AuthenticationManager::~AuthenticationManager() = default;
+AuthenticationManager::~AuthenticationManager() {
+    invalidation_running_.store(false);
+    if (invalidation_thread_.joinable()) {
+        // The subscriber blocks in consume(); give it a moment to notice the
+        // shutdown flag, then detach rather than hang the whole process exit.
+        auto join_future = std::async(std::launch::async, [this]() {
+            invalidation_thread_.join();
+        });
+        if (join_future.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout) {
+            invalidation_thread_.detach();
+        }
+    }
+}
 
 bool AuthenticationManager::initialize() {
     if (!redis_client_) {
         std::cerr << "Redis client not initialized" << std::endl;
         return false;
     }
-    
+
     try {
         // Test Redis connection
         auto result = redis_client_->ping();
         std::cout << "Redis connection established: " << result << std::endl;
+
+        // Listen for revoked tokens so cached sessions die before their TTL
+        invalidation_running_.store(true);
+        invalidation_thread_ = std::thread(&AuthenticationManager::invalidationWorker, this);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to connect to Redis: " << e.what() << std::endl;
@@ -46,21 +71,29 @@ bool AuthenticationManager::initialize() {
 }
 
 AuthResult AuthenticationManager::authenticateConnection(ConnectionId conn_id, const std::string& jwt_token) {
-    // Check if connection is already authenticated
+    const auto now = std::chrono::steady_clock::now();
+
+    // Fast path: the connection already holds an unexpired session minted
+    // from this very token. This is what the shared-memory order path hits
+    // per message, so it must not touch Redis in steady state.
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
         auto it = sessions_.find(conn_id);
         if (it != sessions_.end() && it->second.isAuthenticated) {
-            return AuthResult::ALREADY_AUTHENTICATED;
+            if (it->second.token == jwt_token && now < it->second.expiry) {
+                return AuthResult::ALREADY_AUTHENTICATED;
+            }
         }
     }
-    
+
     // Validate JWT token with Redis
     UserId user_id;
     if (!validateJWTWithRedis(jwt_token, user_id)) {
+        // The token no longer validates; drop any session it minted
+        removeSession(conn_id);
         return AuthResult::INVALID_TOKEN;
     }
-    
+
     // Ensure account is loaded in memory
     if (!getAccount(user_id)) {
         if (!loadAccountFromDatabase(user_id)) {
@@ -68,30 +101,117 @@ AuthResult AuthenticationManager::authenticateConnection(ConnectionId conn_id, c
             return AuthResult::USER_NOT_FOUND;
         }
     }
-    
+
     // Create/update session
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        sessions_[conn_id] = Session(user_id);
+        std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+        sessions_[conn_id] = Session(user_id, jwt_token,
+                                     now + std::chrono::seconds(auth_cache_ttl_sec_));
     }
-    
+
     std::cout << "User " << user_id << " authenticated successfully on connection " << conn_id << std::endl;
     return AuthResult::SUCCESS;
 }
 
 bool AuthenticationManager::isAuthenticated(ConnectionId conn_id) {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
-    auto it = sessions_.find(conn_id);
-    return it != sessions_.end() && it->second.isAuthenticated;
+    {
+        std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(conn_id);
+        if (it == sessions_.end() || !it->second.isAuthenticated) {
+            return false;
+        }
+        if (std::chrono::steady_clock::now() < it->second.expiry) {
+            return true;
+        }
+    }
+    // Cache entry expired: re-check the stored token against Redis once
+    return refreshSession(conn_id);
 }
 
 UserId AuthenticationManager::getUserId(ConnectionId conn_id) {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    {
+        std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(conn_id);
+        if (it == sessions_.end() || !it->second.isAuthenticated) {
+            return "";
+        }
+        if (std::chrono::steady_clock::now() < it->second.expiry) {
+            return it->second.userId;
+        }
+    }
+    if (!refreshSession(conn_id)) {
+        return "";
+    }
+    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(conn_id);
+    return it != sessions_.end() ? it->second.userId : "";
+}
+
+AuthResult AuthenticationManager::authenticateToken(const std::string& jwt_token, UserId& user_id) {
+    const auto now = std::chrono::steady_clock::now();
+
+    // Fast path: shared-lock probe of the validated-token cache
+    {
+        std::shared_lock<std::shared_mutex> lock(token_cache_mutex_);
+        auto it = token_cache_.find(jwt_token);
+        if (it != token_cache_.end() && now < it->second.expiry) {
+            user_id = it->second.user_id;
+            return AuthResult::SUCCESS;
+        }
+    }
+
+    // Miss or expired: one Redis round trip, then cache the result
+    if (!validateJWTWithRedis(jwt_token, user_id)) {
+        std::unique_lock<std::shared_mutex> lock(token_cache_mutex_);
+        token_cache_.erase(jwt_token);
+        return AuthResult::INVALID_TOKEN;
+    }
+
+    // Ensure account is loaded in memory
+    if (!getAccount(user_id)) {
+        if (!loadAccountFromDatabase(user_id)) {
+            std::cerr << "Failed to load account for user: " << user_id << std::endl;
+            return AuthResult::USER_NOT_FOUND;
+        }
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(token_cache_mutex_);
+        token_cache_[jwt_token] = CachedToken{
+            user_id, now + std::chrono::seconds(auth_cache_ttl_sec_)};
+    }
+    return AuthResult::SUCCESS;
+}
+
+bool AuthenticationManager::refreshSession(ConnectionId conn_id) {
+    std::string token;
+    UserId cached_user;
+    {
+        std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+        auto it = sessions_.find(conn_id);
+        if (it == sessions_.end() || !it->second.isAuthenticated) {
+            return false;
+        }
+        token = it->second.token;
+        cached_user = it->second.userId;
+    }
+
+    UserId user_id;
+    if (!validateJWTWithRedis(token, user_id) || user_id != cached_user) {
+        std::cout << "Session for user " << cached_user << " on connection " << conn_id
+                  << " failed re-validation, removing" << std::endl;
+        removeSession(conn_id);
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
     auto it = sessions_.find(conn_id);
-    if (it != sessions_.end() && it->second.isAuthenticated) {
-        return it->second.userId;
+    if (it == sessions_.end()) {
+        return false;  // Invalidated while we were talking to Redis
     }
-    return "";
+    it->second.expiry = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(auth_cache_ttl_sec_);
+    return true;
 }
 
 Account* AuthenticationManager::getAccount(const UserId& user_id) {
@@ -116,11 +236,18 @@ bool AuthenticationManager::loadAccountFromDatabase(const UserId& user_id) {
             // Create in-memory account from database data
             auto account = std::make_unique<Account>();
             account->cash.store(db_account.cash);
-            account->aapl_qty.store(db_account.aapl_qty);
-            account->googl_qty.store(db_account.googl_qty);
-            account->msft_qty.store(db_account.msft_qty);
-            account->amzn_qty.store(db_account.amzn_qty);
-            account->tsla_qty.store(db_account.tsla_qty);
+            // Bridge the legacy per-symbol columns into the SoA position
+            // store; symbols absent from the configured universe are dropped.
+            auto load_position = [&](const char* symbol, int64_t qty) {
+                if (auto* slot = locatePosition(account.get(), symbol)) {
+                    slot->store(qty);
+                }
+            };
+            load_position("AAPL", db_account.aapl_qty);
+            load_position("GOOGL", db_account.googl_qty);
+            load_position("MSFT", db_account.msft_qty);
+            load_position("AMZN", db_account.amzn_qty);
+            load_position("TSLA", db_account.tsla_qty);
             account->buying_power.store(db_account.buying_power);
             account->day_trading_buying_power.store(db_account.day_trading_buying_power);
             account->total_trades.store(db_account.total_trades);
@@ -160,7 +287,7 @@ bool AuthenticationManager::loadAccountFromDatabase(const UserId& user_id) {
 }
 
 void AuthenticationManager::removeSession(ConnectionId conn_id) {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
     auto it = sessions_.find(conn_id);
     if (it != sessions_.end()) {
         std::cout << "Removing session for user: " << it->second.userId << " on connection " << conn_id << std::endl;
@@ -169,7 +296,7 @@ void AuthenticationManager::removeSession(ConnectionId conn_id) {
 }
 
 void AuthenticationManager::updateLastActivity(ConnectionId conn_id) {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
     auto it = sessions_.find(conn_id);
     if (it != sessions_.end()) {
         it->second.lastActivity = std::chrono::steady_clock::now();
@@ -178,8 +305,8 @@ void AuthenticationManager::updateLastActivity(ConnectionId conn_id) {
 
 void AuthenticationManager::cleanupInactiveSessions(std::chrono::minutes timeout) {
     auto now = std::chrono::steady_clock::now();
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
-    
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+
     auto it = sessions_.begin();
     while (it != sessions_.end()) {
         if (now - it->second.lastActivity > timeout) {
@@ -378,24 +505,16 @@ std::atomic<int64_t>* AuthenticationManager::locatePosition(Account* account, co
     if (!account) {
         return nullptr;
     }
-    if (symbol == "GOOGL" || symbol == "GOOG") return &account->googl_qty;
-    if (symbol == "AAPL") return &account->aapl_qty;
-    if (symbol == "TSLA") return &account->tsla_qty;
-    if (symbol == "MSFT") return &account->msft_qty;
-    if (symbol == "AMZN") return &account->amzn_qty;
-    return nullptr;
+    // An unconfigured symbol resolves to the invalid handle and falls out
+    // as nullptr, matching the old "unknown symbol" rejection.
+    return account->position(static_cast<SymbolHandle>(InternTable::symbols().find(symbol)));
 }
 
 std::atomic<int64_t>* AuthenticationManager::locateReservedPosition(Account* account, const std::string& symbol) {
     if (!account) {
         return nullptr;
     }
-    if (symbol == "GOOGL" || symbol == "GOOG") return &account->reserved_googl;
-    if (symbol == "AAPL") return &account->reserved_aapl;
-    if (symbol == "TSLA") return &account->reserved_tsla;
-    if (symbol == "MSFT") return &account->reserved_msft;
-    if (symbol == "AMZN") return &account->reserved_amzn;
-    return nullptr;
+    return account->reservedPosition(static_cast<SymbolHandle>(InternTable::symbols().find(symbol)));
 }
 
 void AuthenticationManager::consumeReservationForTrade(const std::string& order_id,
@@ -444,7 +563,7 @@ void AuthenticationManager::consumeReservationForTrade(const std::string& order_
 }
 
 size_t AuthenticationManager::getActiveSessionCount() {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
     return sessions_.size();
 }
 
@@ -468,11 +587,17 @@ void AuthenticationManager::syncAllAccountsToDatabase() {
         DatabaseManager::UserAccount db_account;
         db_account.user_id = user_id;
         db_account.cash = account->cash.load();
-        db_account.aapl_qty = account->aapl_qty.load();
-        db_account.googl_qty = account->googl_qty.load();
-        db_account.msft_qty = account->msft_qty.load();
-        db_account.amzn_qty = account->amzn_qty.load();
-        db_account.tsla_qty = account->tsla_qty.load();
+        auto position_of = [&](const char* symbol) -> int64_t {
+            if (auto* slot = locatePosition(account.get(), symbol)) {
+                return slot->load();
+            }
+            return 0;
+        };
+        db_account.aapl_qty = position_of("AAPL");
+        db_account.googl_qty = position_of("GOOGL");
+        db_account.msft_qty = position_of("MSFT");
+        db_account.amzn_qty = position_of("AMZN");
+        db_account.tsla_qty = position_of("TSLA");
         db_account.buying_power = account->buying_power.load();
         db_account.day_trading_buying_power = account->day_trading_buying_power.load();
         db_account.total_trades = account->total_trades.load();
@@ -509,10 +634,15 @@ void AuthenticationManager::clearCachedAccounts() {
     }
 
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
         sessions_.clear();
     }
 
+    {
+        std::unique_lock<std::shared_mutex> lock(token_cache_mutex_);
+        token_cache_.clear();
+    }
+
     std::cout << "Authentication cache cleared; accounts will be reloaded from database on next use" << std::endl;
 }
 
@@ -543,6 +673,51 @@ bool AuthenticationManager::validateJWTWithRedis(const std::string& jwt_token, U
     }
 }
 
+void AuthenticationManager::invalidationWorker() {
+    while (invalidation_running_.load()) {
+        try {
+            auto subscriber = redis_client_->subscriber();
+            subscriber.on_message([this](const std::string& /*channel*/, const std::string& token) {
+                invalidateToken(token);
+            });
+            subscriber.subscribe(INVALIDATION_CHANNEL);
+            std::cout << "Auth invalidation listener subscribed to " << INVALIDATION_CHANNEL << std::endl;
+
+            while (invalidation_running_.load()) {
+                subscriber.consume();
+            }
+        } catch (const std::exception& e) {
+            if (!invalidation_running_.load()) {
+                break;
+            }
+            // Redis hiccup: the cache TTL keeps bounding token lifetime
+            // while we reconnect, so just back off and retry.
+            std::cerr << "Auth invalidation listener error: " << e.what()
+                      << ", reconnecting in 1s" << std::endl;
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void AuthenticationManager::invalidateToken(const std::string& jwt_token) {
+    {
+        std::unique_lock<std::shared_mutex> lock(token_cache_mutex_);
+        token_cache_.erase(jwt_token);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    auto it = sessions_.begin();
+    while (it != sessions_.end()) {
+        if (it->second.token == jwt_token) {
+            std::cout << "Token invalidated, removing session for user: "
+                      << it->second.userId << " on connection " << it->first << std::endl;
+            it = sessions_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 bool AuthenticationManager::createAccountEntry(const UserId& user_id, const Account& account_data) {
     auto new_account = std::make_unique<Account>(account_data);
     
@@ -9,13 +9,14 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <string>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
-#include <unordered_map>
+#include <thread>
 #include <sw/redis++/redis++.h>
 #include "absl/container/flat_hash_map.h"
 #include "../core_engine/DatabaseManager.h"
@@ -33,14 +34,18 @@ using CashAmount = int64_t;
 
 // Represents a user's financial state in memory
 struct Account {
+    // Positions as a structure-of-arrays indexed by interned symbol handle
+    // (1-based, deterministic configuration order - see InternTable). A risk
+    // check is two array loads (qty and reserved qty at the same index)
+    // instead of a chain of symbol-string comparisons, and growing the
+    // universe means bumping MAX_SYMBOL_SLOTS rather than adding a field
+    // per symbol. Slot 0 is the invalid handle and stays unused.
+    static constexpr size_t MAX_SYMBOL_SLOTS = 256;
+
     std::atomic<CashAmount> cash;
-    std::atomic<int64_t> aapl_qty;
-    std::atomic<int64_t> googl_qty;
-    std::atomic<int64_t> msft_qty;
-    std::atomic<int64_t> amzn_qty;
-    std::atomic<int64_t> tsla_qty;
-    // Add more positions as needed
-    
+    std::array<std::atomic<int64_t>, MAX_SYMBOL_SLOTS> positions;
+    std::array<std::atomic<int64_t>, MAX_SYMBOL_SLOTS> reserved_positions;
+
     // Risk metrics
     std::atomic<CashAmount> buying_power;
     std::atomic<CashAmount> day_trading_buying_power;
@@ -48,53 +53,47 @@ struct Account {
     std::atomic<long long> realized_pnl;
     std::atomic<bool> is_active;
     std::atomic<CashAmount> reserved_cash;
-    std::atomic<int64_t> reserved_aapl;
-    std::atomic<int64_t> reserved_googl;
-    std::atomic<int64_t> reserved_msft;
-    std::atomic<int64_t> reserved_amzn;
-    std::atomic<int64_t> reserved_tsla;
     mutable std::mutex account_mutex;
-    
+
     // Constructor to initialize atomic values
-    Account(CashAmount initial_cash = 0) 
+    Account(CashAmount initial_cash = 0)
         : cash(initial_cash)
-        , aapl_qty(0)
-        , googl_qty(0)
-        , msft_qty(0)
-        , amzn_qty(0)
-        , tsla_qty(0)
         , buying_power(initial_cash)
         , day_trading_buying_power(initial_cash)
         , total_trades(0)
         , realized_pnl(0)
         , is_active(true)
-        , reserved_cash(0)
-    , reserved_aapl(0)
-    , reserved_googl(0)
-    , reserved_msft(0)
-    , reserved_amzn(0)
-    , reserved_tsla(0) {
+        , reserved_cash(0) {
+        for (size_t i = 0; i < MAX_SYMBOL_SLOTS; ++i) {
+            positions[i].store(0, std::memory_order_relaxed);
+            reserved_positions[i].store(0, std::memory_order_relaxed);
+        }
     }
-    
+
     // Copy constructor for atomic types
     Account(const Account& other)
         : cash(other.cash.load())
-        , aapl_qty(other.aapl_qty.load())
-        , googl_qty(other.googl_qty.load())
-        , msft_qty(other.msft_qty.load())
-        , amzn_qty(other.amzn_qty.load())
-        , tsla_qty(other.tsla_qty.load())
         , buying_power(other.buying_power.load())
         , day_trading_buying_power(other.day_trading_buying_power.load())
         , total_trades(other.total_trades.load())
         , realized_pnl(other.realized_pnl.load())
         , is_active(other.is_active.load())
-        , reserved_cash(other.reserved_cash.load())
-    , reserved_aapl(other.reserved_aapl.load())
-    , reserved_googl(other.reserved_googl.load())
-    , reserved_msft(other.reserved_msft.load())
-    , reserved_amzn(other.reserved_amzn.load())
-    , reserved_tsla(other.reserved_tsla.load()) {
+        , reserved_cash(other.reserved_cash.load()) {
+        for (size_t i = 0; i < MAX_SYMBOL_SLOTS; ++i) {
+            positions[i].store(other.positions[i].load(), std::memory_order_relaxed);
+            reserved_positions[i].store(other.reserved_positions[i].load(), std::memory_order_relaxed);
+        }
+    }
+
+    // Position slots by interned handle; nullptr for the invalid handle or
+    // a handle beyond the configured universe.
+    std::atomic<int64_t>* position(SymbolHandle handle) {
+        if (handle == 0 || handle >= MAX_SYMBOL_SLOTS) return nullptr;
+        return &positions[handle];
+    }
+    std::atomic<int64_t>* reservedPosition(SymbolHandle handle) {
+        if (handle == 0 || handle >= MAX_SYMBOL_SLOTS) return nullptr;
+        return &reserved_positions[handle];
     }
 
     // Helper functions for conversion
@@ -103,14 +102,25 @@ struct Account {
     double buyingPowerToDouble() const { return static_cast<double>(buying_power.load()) / 100.0; }
 };
 
-// Represents a client's live connection state
+// Represents a client's live connection state. The session doubles as the
+// validated-token cache entry: while `expiry` is in the future the per-order
+// auth check is answered from this struct alone, without touching Redis.
+// Once expired the next check re-validates the stored token against Redis
+// and extends the deadline, so a revoked token stops trading within one
+// cache TTL even if the pub/sub invalidation channel is down.
 struct Session {
     UserId userId;
     bool isAuthenticated = false;
     std::chrono::steady_clock::time_point lastActivity;
-    
-    Session() : lastActivity(std::chrono::steady_clock::now()) {}
-    Session(const UserId& id) : userId(id), isAuthenticated(true), lastActivity(std::chrono::steady_clock::now()) {}
+    std::string token;                             // Token the session was minted from
+    std::chrono::steady_clock::time_point expiry;  // Re-validate against Redis after this
+
+    Session() : lastActivity(std::chrono::steady_clock::now()), expiry(lastActivity) {}
+    Session(const UserId& id, const std::string& jwt_token,
+            std::chrono::steady_clock::time_point expires_at)
+        : userId(id), isAuthenticated(true),
+          lastActivity(std::chrono::steady_clock::now()),
+          token(jwt_token), expiry(expires_at) {}
 };
 
 // Authentication result
@@ -160,13 +170,42 @@ private:
     absl::flat_hash_map<UserId, std::unique_ptr<Account>> accounts_;
     std::shared_mutex accounts_mutex_; // Allow concurrent reads, exclusive writes
     
-    // Maps a live connection to its authenticated session
-    std::unordered_map<ConnectionId, Session> sessions_;
-    std::mutex sessions_mutex_; // Protects the sessions map from concurrent access
-    
+    // Maps a live connection to its authenticated session. Per-order checks
+    // (isAuthenticated/getUserId, called once per inbound order) take the
+    // shared side of the lock so concurrent readers never serialize on each
+    // other; the exclusive side is only taken at login, logout and token
+    // invalidation. Entries carry a TTL (AUREX_AUTH_CACHE_TTL_SEC, default
+    // 30s) after which the stored token is re-validated against Redis once.
+    absl::flat_hash_map<ConnectionId, Session> sessions_;
+    std::shared_mutex sessions_mutex_;
+
+    // Cache TTL and the Redis pub/sub invalidation listener. A PUBLISH of a
+    // raw token on INVALIDATION_CHANNEL evicts every session minted from it
+    // immediately; the TTL above is the backstop when Redis is unreachable.
+    int auth_cache_ttl_sec_{30};
+    std::atomic<bool> invalidation_running_{false};
+    std::thread invalidation_thread_;
+    void invalidationWorker();
+    void invalidateToken(const std::string& jwt_token);
+    bool refreshSession(ConnectionId conn_id);
+
+    // Token-keyed companion cache for order paths that do not hold a live
+    // connection (the shared-memory server authenticates every message with
+    // a throwaway connection id, so the session map above never hits for
+    // it). Entries share the session TTL and the pub/sub invalidation.
+    struct CachedToken {
+        UserId user_id;
+        std::chrono::steady_clock::time_point expiry;
+    };
+    absl::flat_hash_map<std::string, CachedToken> token_cache_;
+    std::shared_mutex token_cache_mutex_;
+
     // Redis key prefix for trading tokens
     static constexpr const char* TRADING_TOKEN_PREFIX = "trading:";
 
+    // Channel carrying revoked tokens (published by the auth service on logout)
+    static constexpr const char* INVALIDATION_CHANNEL = "trading:invalidate";
+
 public:
     AuthenticationManager(const std::string& redis_host, int redis_port, DatabaseManager* db_manager);
     ~AuthenticationManager();
@@ -176,6 +215,9 @@ public:
     
     // Authentication methods
     AuthResult authenticateConnection(ConnectionId conn_id, const std::string& jwt_token);
+    // Connection-less token check for per-message order paths: answered from
+    // the token cache in steady state, Redis only on a miss or expiry.
+    AuthResult authenticateToken(const std::string& jwt_token, UserId& user_id);
     bool isAuthenticated(ConnectionId conn_id);
     bool reserveForOrder(const Order& order, Price effective_price, std::string& reason);
     void releaseForOrder(const Order& order, const std::string& reason);
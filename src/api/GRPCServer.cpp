@@ -10,14 +10,20 @@
 #include "GRPCServer.h"
 #include "common/EngineTelemetry.h"
 #include "common/EngineLogging.h"
+#include "common/InternTable.h"
 #include <iostream>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <thread>
 #include <fstream>
 #include <vector>
 #include <algorithm>
 #include <atomic>
+#include <map>
+#include <memory>
 #include <iomanip>
+#include <google/protobuf/arena.h>
 
 GRPCServer::GRPCServer(const std::string& db_connection_string)
     : exchange_(std::make_unique<StockExchange>(db_connection_string)) {}
@@ -74,6 +80,123 @@ grpc::Status GRPCServer::SubmitOrder(grpc::ServerContext* context,
                         "Trading over gRPC has been retired. Use the TLS-encrypted TCP interface instead.");
 }
 
+// Pipelined order entry for algo clients that stay on gRPC. Unary
+// SubmitOrder pays full request/response overhead per order; here one HTTP/2
+// stream amortises the framing, the client keeps sending without waiting for
+// acks, and acks come back on the same stream correlated by the client's
+// order_id. The RPC thread reads and submits; a dedicated writer thread
+// drains the ack queue so a slow client-side receive window never stalls
+// order reads. Per-message protobufs come from an arena that is reset
+// periodically, so steady-state streaming does no heap allocation for
+// request/response objects.
+grpc::Status GRPCServer::StreamOrders(grpc::ServerContext* context,
+                                      grpc::ServerReaderWriter<stock::OrderResponse,
+                                                               stock::OrderRequest>* stream) {
+    if (!exchange_) return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "Exchange not initialized");
+
+    struct Ack {
+        std::string order_id;
+        bool accepted;
+        std::string message;
+    };
+
+    std::mutex ack_mutex;
+    std::condition_variable ack_cv;
+    std::deque<Ack> pending_acks;
+    bool reads_done = false;
+    std::atomic<bool> stream_ok{true};
+
+    std::thread writer([&]() {
+        google::protobuf::Arena arena;
+        auto* response = google::protobuf::Arena::Create<stock::OrderResponse>(&arena);
+        std::unique_lock<std::mutex> lock(ack_mutex);
+        for (;;) {
+            ack_cv.wait(lock, [&]() { return !pending_acks.empty() || reads_done; });
+            if (pending_acks.empty() && reads_done) {
+                return;
+            }
+            std::deque<Ack> batch;
+            batch.swap(pending_acks);
+            lock.unlock();
+
+            for (const auto& ack : batch) {
+                response->Clear();
+                response->set_order_id(ack.order_id);
+                response->set_accepted(ack.accepted);
+                response->set_message(ack.message);
+                if (!stream->Write(*response)) {
+                    // Client went away; stop the read loop and discard the
+                    // rest - the orders themselves are already submitted
+                    stream_ok.store(false, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            lock.lock();
+        }
+    });
+
+    // Reuse one arena-backed request across reads; reset the arena every few
+    // thousand messages so embedded string growth stays bounded
+    google::protobuf::Arena request_arena;
+    auto* request = google::protobuf::Arena::Create<stock::OrderRequest>(&request_arena);
+    size_t messages_on_arena = 0;
+    constexpr size_t ARENA_RESET_INTERVAL = 4096;
+
+    while (stream_ok.load(std::memory_order_relaxed) && stream->Read(request)) {
+        Ack ack;
+        ack.order_id = request->order_id();
+
+        if (request->order_id().empty() || request->user_id().empty() ||
+            request->symbol().empty() || request->quantity() <= 0) {
+            ack.accepted = false;
+            ack.message = "rejected: malformed order";
+        } else {
+            int64_t timestamp_ms = request->timestamp_ms();
+            if (timestamp_ms <= 0) {
+                timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            Order core_order(request->order_id(), request->user_id(), request->symbol(),
+                             static_cast<int>(request->side()), static_cast<int>(request->type()),
+                             request->quantity(), Order::fromDouble(request->price()),
+                             timestamp_ms);
+            // Resolve interned handles once at the edge, same as the TCP path
+            core_order.user_handle = static_cast<UserHandle>(InternTable::users().intern(request->user_id()));
+            core_order.symbol_handle = static_cast<SymbolHandle>(InternTable::symbols().intern(request->symbol()));
+            core_order.order_seq = nextOrderSequence();
+
+            ack.message = exchange_->submitOrder(request->symbol(), core_order);
+            ack.accepted = (ack.message == "accepted");
+            EngineTelemetry::instance().recordOrder();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(ack_mutex);
+            pending_acks.push_back(std::move(ack));
+        }
+        ack_cv.notify_one();
+
+        if (++messages_on_arena == ARENA_RESET_INTERVAL) {
+            request_arena.Reset();
+            request = google::protobuf::Arena::Create<stock::OrderRequest>(&request_arena);
+            messages_on_arena = 0;
+        } else {
+            request->Clear();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ack_mutex);
+        reads_done = true;
+    }
+    ack_cv.notify_one();
+    writer.join();
+
+    (void)context;
+    return grpc::Status::OK;
+}
+
 grpc::Status GRPCServer::OrderStatus(grpc::ServerContext* context,
                                      const stock::OrderStatusRequest* request,
                                      stock::OrderStatusResponse* response) {
@@ -105,15 +228,23 @@ grpc::Status GRPCServer::StreamMarketData(grpc::ServerContext* context,
         if (!writer->Write(out)) return grpc::Status::OK; // client closed
     }
 
-    // Simple periodic updates (polling) to keep compile-time simple
+    // Conflated updates: poll each symbol's atomic slot and write only when
+    // the exchange has published a fresh snapshot. A slow client skips
+    // straight to the newest state instead of queueing stale updates.
+    std::map<std::string, std::shared_ptr<const MarketDataUpdate>> last_sent;
     while (!context->IsCancelled()) {
+        bool wrote = false;
         for (const auto& sym : subs) {
-            auto md = exchange_->getMarketData(sym);
+            auto latest = exchange_->latestMarketData(sym);
+            if (!latest || latest == last_sent[sym]) continue;
+            last_sent[sym] = latest;
+
             stock::MarketDataUpdate out;
-            convertFromCoreMarketData(md, out);
+            convertFromCoreMarketData(*latest, out);
             if (!writer->Write(out)) return grpc::Status::OK;
+            wrote = true;
         }
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(wrote ? 10 : 100));
     }
 
     return grpc::Status::OK;
@@ -145,9 +276,18 @@ grpc::Status GRPCServer::StreamAllStocks(grpc::ServerContext* context,
 
     bool include_order_book = request->include_order_book();
 
+    // Conflated stream: consume the immutable snapshot the exchange publishes
+    // once per tick instead of rebuilding it per stream
+    std::shared_ptr<const std::vector<StockSnapshot>> last_sent;
     while (!context->IsCancelled()) {
-        auto snapshots = exchange_->getAllStocksSnapshot(include_order_book);
-        
+        auto latest = exchange_->latestAllStocksSnapshot();
+        if (!latest || latest == last_sent) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        last_sent = latest;
+        const auto& snapshots = *latest;
+
         stock::AllStocksUpdate update;
         auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
@@ -176,7 +316,6 @@ grpc::Status GRPCServer::StreamAllStocks(grpc::ServerContext* context,
         }
         
         if (!writer->Write(update)) return grpc::Status::OK;
-        std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
     return grpc::Status::OK;
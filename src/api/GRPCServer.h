@@ -48,7 +48,13 @@ public:
     grpc::Status OrderStatus(grpc::ServerContext* context,
                             const stock::OrderStatusRequest* request,
                             stock::OrderStatusResponse* response) override;
-    
+
+    // Bidirectional stream: pipelined order entry with acks correlated by
+    // the client's order id (see GRPCServer.cpp for the threading model)
+    grpc::Status StreamOrders(grpc::ServerContext* context,
+                              grpc::ServerReaderWriter<stock::OrderResponse,
+                                                       stock::OrderRequest>* stream) override;
+
     // Streaming RPCs
     grpc::Status StreamMarketData(grpc::ServerContext* context,
                                  const stock::MarketDataRequest* request,
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#include "MulticastFeed.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include "../common/InternTable.h"
+
+MulticastFeed::MulticastFeed(StockExchange* exchange) : exchange_(exchange) {
+    const char* group = std::getenv("AUREX_FEED_GROUP");
+    if (!group || !*group) {
+        return;  // Feed is opt-in; without a group the engine runs as before
+    }
+    group_ = group;
+    enabled_ = true;
+
+    if (const char* port = std::getenv("AUREX_FEED_PORT")) {
+        port_ = static_cast<uint16_t>(std::atoi(port));
+    }
+    if (const char* interval = std::getenv("AUREX_FEED_SNAPSHOT_INTERVAL_MS")) {
+        snapshot_interval_ms_ = std::max(100, std::atoi(interval));
+    }
+}
+
+MulticastFeed::~MulticastFeed() {
+    stop();
+}
+
+bool MulticastFeed::start() {
+    if (!enabled_ || running_.exchange(true)) {
+        return enabled_;
+    }
+
+    boost::system::error_code ec;
+    auto group = boost::asio::ip::make_address(group_, ec);
+    if (ec) {
+        std::cerr << "⚠️ Multicast feed disabled: bad AUREX_FEED_GROUP '" << group_
+                  << "': " << ec.message() << std::endl;
+        running_.store(false);
+        enabled_ = false;
+        return false;
+    }
+    incremental_endpoint_ = boost::asio::ip::udp::endpoint(group, port_);
+    snapshot_endpoint_ = boost::asio::ip::udp::endpoint(group, static_cast<uint16_t>(port_ + 1));
+
+    socket_.open(incremental_endpoint_.protocol(), ec);
+    if (ec) {
+        std::cerr << "⚠️ Multicast feed disabled: socket open failed: " << ec.message()
+                  << std::endl;
+        running_.store(false);
+        enabled_ = false;
+        return false;
+    }
+    // Keep the feed inside the colo fabric
+    socket_.set_option(boost::asio::ip::multicast::hops(4), ec);
+
+    // The feed taps the same streams the gRPC fan-out consumes, one hop
+    // after marketDataWorker drains market_data_queue_, so no socket work
+    // ever runs on a matching thread
+    exchange_->registerTradeObserver([this](const Trade& trade) { publishTrade(trade); });
+    for (const auto& symbol : exchange_->getSymbols()) {
+        exchange_->subscribeToMarketData(
+            symbol, [this](const MarketDataUpdate& update) { publishDepth(update); });
+    }
+
+    snapshot_thread_ = std::thread(&MulticastFeed::snapshotWorker, this);
+
+    std::cout << "📡 Multicast feed publishing to " << group_ << ":" << port_
+              << " (snapshots on :" << (port_ + 1) << ")" << std::endl;
+    return true;
+}
+
+void MulticastFeed::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (snapshot_thread_.joinable()) {
+        auto join_future =
+            std::async(std::launch::async, [this]() { snapshot_thread_.join(); });
+        if (join_future.wait_for(std::chrono::milliseconds(200)) ==
+            std::future_status::timeout) {
+            std::cerr << "⚠️ Feed snapshot thread join timeout - detaching" << std::endl;
+            snapshot_thread_.detach();
+        }
+    }
+
+    boost::system::error_code ec;
+    socket_.close(ec);
+}
+
+void MulticastFeed::publishTrade(const Trade& trade) {
+    if (!running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    FeedMessage msg{};
+    msg.type = FEED_MSG_TRADE;
+    msg.symbol_id = static_cast<uint16_t>(InternTable::symbols().find(trade.symbol));
+    msg.price = trade.price;
+    msg.quantity = trade.quantity;
+    msg.timestamp_ms = trade.timestamp_ms;
+
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    sendIncrementalLocked(msg);
+}
+
+void MulticastFeed::publishDepth(const MarketDataUpdate& update) {
+    if (!running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const uint16_t symbol_id =
+        static_cast<uint16_t>(InternTable::symbols().find(update.symbol));
+
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    PublishedBook& book = published_books_[update.symbol];
+    diffSideLocked(symbol_id, 0, book.bids, update.top_bids, update.timestamp_ms);
+    diffSideLocked(symbol_id, 1, book.asks, update.top_asks, update.timestamp_ms);
+    book.bids = update.top_bids;
+    book.asks = update.top_asks;
+}
+
+// Turn two consecutive top-of-book snapshots into per-level deltas. A level
+// whose price changed is a replacement at that depth and goes out as ADD; a
+// quantity change at the same price is MODIFY; levels past the new depth are
+// DELETEd with their old price so receivers can drop them by price.
+void MulticastFeed::diffSideLocked(uint16_t symbol_id, uint8_t side,
+                                   const std::vector<PriceLevel>& prev,
+                                   const std::vector<PriceLevel>& next,
+                                   int64_t timestamp_ms) {
+    FeedMessage msg{};
+    msg.type = FEED_MSG_LEVEL;
+    msg.side = side;
+    msg.symbol_id = symbol_id;
+    msg.timestamp_ms = timestamp_ms;
+
+    const size_t common = std::min(prev.size(), next.size());
+    for (size_t i = 0; i < common; ++i) {
+        if (prev[i].price == next[i].price && prev[i].quantity == next[i].quantity) {
+            continue;
+        }
+        msg.action = (prev[i].price == next[i].price) ? FEED_LEVEL_MODIFY : FEED_LEVEL_ADD;
+        msg.depth = static_cast<uint8_t>(i);
+        msg.price = next[i].price;
+        msg.quantity = next[i].quantity;
+        sendIncrementalLocked(msg);
+    }
+    for (size_t i = common; i < next.size(); ++i) {
+        msg.action = FEED_LEVEL_ADD;
+        msg.depth = static_cast<uint8_t>(i);
+        msg.price = next[i].price;
+        msg.quantity = next[i].quantity;
+        sendIncrementalLocked(msg);
+    }
+    for (size_t i = common; i < prev.size(); ++i) {
+        msg.action = FEED_LEVEL_DELETE;
+        msg.depth = static_cast<uint8_t>(i);
+        msg.price = prev[i].price;
+        msg.quantity = 0;
+        sendIncrementalLocked(msg);
+    }
+}
+
+void MulticastFeed::sendIncrementalLocked(FeedMessage& msg) {
+    msg.seq = sequence_.fetch_add(1, std::memory_order_relaxed) + 1;
+    boost::system::error_code ec;
+    socket_.send_to(boost::asio::buffer(&msg, sizeof(msg)), incremental_endpoint_, 0, ec);
+    // Dropped datagrams are the receiver's problem by design: they detect the
+    // sequence gap and recover from the snapshot channel
+}
+
+// Recovery channel: every cycle, replay the symbol directory and the full
+// top-of-book (from the seqlock depth snapshots) for each symbol. Every
+// record carries the incremental sequence current when the cycle started, so
+// a receiver applies the snapshot and resumes from that seq.
+void MulticastFeed::snapshotWorker() {
+    while (running_.load(std::memory_order_relaxed)) {
+        // Sleep in short steps so stop() is not held up by the interval
+        for (int slept = 0;
+             slept < snapshot_interval_ms_ && running_.load(std::memory_order_relaxed);
+             slept += 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        if (!running_.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        const uint64_t cycle_seq = sequence_.load(std::memory_order_relaxed);
+        boost::system::error_code ec;
+
+        for (const auto& symbol : exchange_->getSymbols()) {
+            FeedSymbolDirectory dir{};
+            dir.seq = cycle_seq;
+            dir.type = FEED_MSG_SYMBOL_DIRECTORY;
+            dir.symbol_id = static_cast<uint16_t>(InternTable::symbols().find(symbol));
+            std::strncpy(dir.symbol, symbol.c_str(), sizeof(dir.symbol) - 1);
+            socket_.send_to(boost::asio::buffer(&dir, sizeof(dir)), snapshot_endpoint_, 0, ec);
+
+            MarketDataUpdate book = exchange_->getMarketData(symbol);
+            FeedMessage msg{};
+            msg.seq = cycle_seq;
+            msg.type = FEED_MSG_SNAPSHOT_LEVEL;
+            msg.symbol_id = dir.symbol_id;
+            msg.timestamp_ms = book.timestamp_ms;
+            for (uint8_t side = 0; side < 2; ++side) {
+                const auto& levels = (side == 0) ? book.top_bids : book.top_asks;
+                msg.side = side;
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    msg.depth = static_cast<uint8_t>(i);
+                    msg.price = levels[i].price;
+                    msg.quantity = levels[i].quantity;
+                    socket_.send_to(boost::asio::buffer(&msg, sizeof(msg)), snapshot_endpoint_,
+                                    0, ec);
+                }
+            }
+        }
+    }
+}
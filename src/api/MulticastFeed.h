@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include "../core_engine/StockExchange.h"
+
+// ITCH-style incremental market data feed over UDP multicast, for colo
+// clients that do not want per-subscriber protobuf serialization. One
+// send per event reaches every listener regardless of consumer count.
+//
+// Enabled by setting AUREX_FEED_GROUP to a multicast group (e.g. 239.10.1.1).
+// AUREX_FEED_PORT (default 30001) carries the incremental channel; port+1 is
+// the snapshot-recovery channel, which periodically replays the seqlock book
+// snapshots stamped with the live sequence they cover, so a late joiner or a
+// receiver that sees a gap can resynchronise without a TCP side channel.
+//
+// Records are fixed-size and native-endian for the same reason as
+// WireProtocol.h: the feed targets colocated same-architecture clients.
+// symbol_id is the interned symbol handle (1-based config order); the
+// snapshot channel repeats the id-to-ticker directory every cycle.
+
+static constexpr uint8_t FEED_MSG_TRADE = 1;
+static constexpr uint8_t FEED_MSG_LEVEL = 2;           // Incremental book level
+static constexpr uint8_t FEED_MSG_SNAPSHOT_LEVEL = 3;  // Recovery channel level
+static constexpr uint8_t FEED_MSG_SYMBOL_DIRECTORY = 4;
+
+static constexpr uint8_t FEED_LEVEL_ADD = 0;
+static constexpr uint8_t FEED_LEVEL_MODIFY = 1;
+static constexpr uint8_t FEED_LEVEL_DELETE = 2;
+
+#pragma pack(push, 1)
+struct FeedMessage {
+    uint64_t seq;        // Feed-wide sequence; snapshot records carry the live seq they cover
+    uint8_t type;        // FEED_MSG_*
+    uint8_t side;        // 0=bid, 1=ask (level records)
+    uint8_t action;      // FEED_LEVEL_* (level records)
+    uint8_t depth;       // Level index from top of book (level records)
+    uint16_t symbol_id;  // Interned symbol handle (1-based config order)
+    uint16_t reserved;
+    int64_t price;       // Fixed-point cents
+    int64_t quantity;
+    int64_t timestamp_ms;
+};
+
+// Snapshot-channel record mapping symbol_id to its ticker text
+struct FeedSymbolDirectory {
+    uint64_t seq;
+    uint8_t type;  // FEED_MSG_SYMBOL_DIRECTORY
+    uint8_t reserved[5];
+    uint16_t symbol_id;
+    char symbol[16];  // NUL-padded ticker
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FeedMessage) == 40, "FeedMessage must be 40 bytes");
+static_assert(sizeof(FeedSymbolDirectory) == 32, "FeedSymbolDirectory must be 32 bytes");
+
+class MulticastFeed {
+public:
+    explicit MulticastFeed(StockExchange* exchange);
+    ~MulticastFeed();
+
+    bool enabled() const { return enabled_; }
+    bool start();
+    void stop();
+
+private:
+    // Last published top-of-book per symbol, used to turn the depth
+    // snapshots from the market data pump into add/modify/delete deltas
+    struct PublishedBook {
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+    };
+
+    void publishTrade(const Trade& trade);
+    void publishDepth(const MarketDataUpdate& update);
+    void diffSideLocked(uint16_t symbol_id, uint8_t side,
+                        const std::vector<PriceLevel>& prev,
+                        const std::vector<PriceLevel>& next,
+                        int64_t timestamp_ms);
+    void sendIncrementalLocked(FeedMessage& msg);
+    void snapshotWorker();
+
+    StockExchange* exchange_;
+    bool enabled_{false};
+    std::string group_;
+    uint16_t port_{30001};
+    int snapshot_interval_ms_{1000};
+
+    boost::asio::io_context io_context_;
+    boost::asio::ip::udp::socket socket_{io_context_};
+    boost::asio::ip::udp::endpoint incremental_endpoint_;
+    boost::asio::ip::udp::endpoint snapshot_endpoint_;
+
+    std::atomic<uint64_t> sequence_{0};
+    // Serialises sequence assignment with the send so receivers never see
+    // reordered sequence numbers from concurrent stock threads
+    std::mutex send_mutex_;
+    std::map<std::string, PublishedBook> published_books_;
+
+    std::atomic<bool> running_{false};
+    std::thread snapshot_thread_;
+};
@@ -9,13 +9,22 @@
 
 #include "SharedMemoryQueue.h"
 #include "../core_engine/StockExchange.h"
+#include "WireProtocol.h"
 #include "common/EngineTelemetry.h"
+#include <cstdlib>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <memory>
 #include <future>
 #include <limits>
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace boost::interprocess;
 
@@ -29,8 +38,14 @@ SharedMemoryQueue::SharedMemoryQueue(const std::string& name, size_t capacity, s
     // Create shared memory
     shm_ = shared_memory_object(create_only, shm_name_.c_str(), read_write);
 
-    // Calculate total size needed
-    size_t total_size = sizeof(SharedData) + (capacity * message_size);
+    // Round the slot count up to a power of two so indexing is a mask, and
+    // pad each slot to a cache line so adjacent slots never false-share
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    capacity_ = cap;
+    size_t slot_stride = (sizeof(std::atomic<uint64_t>) + message_size + 63) & ~static_cast<size_t>(63);
+
+    size_t total_size = sizeof(SharedData) + (cap * slot_stride);
     shm_.truncate(total_size);
 
     // Map the shared memory
@@ -38,10 +53,23 @@ SharedMemoryQueue::SharedMemoryQueue(const std::string& name, size_t capacity, s
 
     // Initialize shared data
     shared_data_ = new (region_.get_address()) SharedData();
-    shared_data_->capacity = capacity;
+    shared_data_->capacity = cap;
     shared_data_->message_size = message_size;
+    shared_data_->slot_stride = slot_stride;
     shared_data_->head.store(0);
     shared_data_->tail.store(0);
+    shared_data_->consumer_parked.store(0);
+
+    // Each slot starts one lap behind: sequence == index means "free"
+    for (uint64_t i = 0; i < cap; ++i) {
+        new (shared_data_->data + i * slot_stride) std::atomic<uint64_t>(i);
+    }
+
+    // Publish the layout guard last so a client attaching mid-create never
+    // reads a half-initialized ring
+    shared_data_->version = SHM_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    shared_data_->magic = SHM_MAGIC;
 }
 
 SharedMemoryQueue::SharedMemoryQueue(const std::string& name)
@@ -53,6 +81,13 @@ SharedMemoryQueue::SharedMemoryQueue(const std::string& name)
         region_ = mapped_region(shm_, read_write);
         shared_data_ = static_cast<SharedData*>(region_.get_address());
 
+        if (shared_data_->magic != SHM_MAGIC || shared_data_->version != SHM_VERSION) {
+            std::cerr << "SharedMemoryQueue: " << shm_name_
+                      << " has an incompatible layout (server/client version mismatch)" << std::endl;
+            shared_data_ = nullptr;
+            return;
+        }
+
         capacity_ = shared_data_->capacity;
         message_size_ = shared_data_->message_size;
     } catch (const interprocess_exception&) {
@@ -67,6 +102,15 @@ SharedMemoryQueue::~SharedMemoryQueue() {
     }
 }
 
+std::atomic<uint64_t>* SharedMemoryQueue::slotSequence(uint64_t pos) const {
+    char* slot = shared_data_->data + (pos & (capacity_ - 1)) * shared_data_->slot_stride;
+    return reinterpret_cast<std::atomic<uint64_t>*>(slot);
+}
+
+char* SharedMemoryQueue::slotPayload(uint64_t pos) const {
+    return reinterpret_cast<char*>(slotSequence(pos)) + sizeof(std::atomic<uint64_t>);
+}
+
 bool SharedMemoryQueue::enqueue(const void* message, size_t size) {
     if (!shared_data_) return false;
     if (size + sizeof(size_t) > message_size_) {
@@ -74,22 +118,10 @@ bool SharedMemoryQueue::enqueue(const void* message, size_t size) {
         return false;
     }
 
-    scoped_lock<interprocess_mutex> lock(shared_data_->mutex);
-
-    while (full()) {
-        shared_data_->not_full.wait(lock);
+    // Blocking semantics: spin until the consumer frees a slot
+    while (!try_enqueue(message, size)) {
+        std::this_thread::yield();
     }
-
-    size_t head = shared_data_->head.load();
-    char* slot = shared_data_->data + (head * message_size_);
-
-    // Copy message with size prefix
-    *reinterpret_cast<size_t*>(slot) = size;
-    std::memcpy(slot + sizeof(size_t), message, size);
-
-    shared_data_->head.store((head + 1) % capacity_);
-    shared_data_->not_empty.notify_one();
-
     return true;
 }
 
@@ -100,96 +132,117 @@ bool SharedMemoryQueue::try_enqueue(const void* message, size_t size) {
         return false;
     }
 
-    scoped_lock<interprocess_mutex> lock(shared_data_->mutex, try_to_lock);
-    if (!lock.owns()) return false;
-
-    if (full()) return false;
-
-    size_t head = shared_data_->head.load();
-    char* slot = shared_data_->data + (head * message_size_);
-
-    // Copy message with size prefix
-    *reinterpret_cast<size_t*>(slot) = size;
-    std::memcpy(slot + sizeof(size_t), message, size);
-
-    shared_data_->head.store((head + 1) % capacity_);
-    shared_data_->not_empty.notify_one();
-
-    return true;
+    uint64_t pos = shared_data_->head.load(std::memory_order_relaxed);
+    for (;;) {
+        std::atomic<uint64_t>* seq = slotSequence(pos);
+        uint64_t sequence = seq->load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence - pos);
+
+        if (diff == 0) {
+            // Slot is free: claim it with a single CAS on head
+            if (shared_data_->head.compare_exchange_weak(pos, pos + 1,
+                                                         std::memory_order_relaxed)) {
+                char* payload = slotPayload(pos);
+                *reinterpret_cast<size_t*>(payload) = size;
+                std::memcpy(payload + sizeof(size_t), message, size);
+                // Publish: the consumer's acquire load of the sequence
+                // makes the payload visible
+                seq->store(pos + 1, std::memory_order_release);
+                wakeConsumer();
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // Full: this slot has not been released yet
+        } else {
+            pos = shared_data_->head.load(std::memory_order_relaxed);
+        }
+    }
 }
 
 bool SharedMemoryQueue::dequeue(void* message, size_t& size) {
     if (!shared_data_) return false;
 
-    scoped_lock<interprocess_mutex> lock(shared_data_->mutex);
-
-    while (empty()) {
-        shared_data_->not_empty.wait(lock);
+    for (;;) {
+        if (empty()) {
+            waitNotEmpty(1000);
+            continue;
+        }
+        return try_dequeue(message, size);
     }
+}
 
-    size_t tail = shared_data_->tail.load();
-    char* slot = shared_data_->data + (tail * message_size_);
+bool SharedMemoryQueue::try_dequeue(void* message, size_t& size) {
+    if (!shared_data_) return false;
+
+    uint64_t pos = shared_data_->tail.load(std::memory_order_relaxed);
+    std::atomic<uint64_t>* seq = slotSequence(pos);
+    uint64_t sequence = seq->load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence - (pos + 1)) < 0) {
+        return false; // Empty: producer has not published this slot yet
+    }
 
-    // Read message size and data
-    size_t msg_size = *reinterpret_cast<size_t*>(slot);
+    char* payload = slotPayload(pos);
+    size_t msg_size = *reinterpret_cast<size_t*>(payload);
+    bool ok = true;
     if (msg_size + sizeof(size_t) > message_size_) {
         std::cerr << "SharedMemoryQueue: corrupt message size (" << msg_size << " bytes)" << std::endl;
-        shared_data_->tail.store((tail + 1) % capacity_);
-        shared_data_->not_full.notify_one();
-        return false;
+        ok = false;
+    } else {
+        std::memcpy(message, payload + sizeof(size_t), msg_size);
+        size = msg_size;
     }
-    std::memcpy(message, slot + sizeof(size_t), msg_size);
-    size = msg_size;
 
-    shared_data_->tail.store((tail + 1) % capacity_);
-    shared_data_->not_full.notify_one();
+    // Release the slot to producers a full lap ahead
+    shared_data_->tail.store(pos + 1, std::memory_order_relaxed);
+    seq->store(pos + capacity_, std::memory_order_release);
 
-    return true;
+    return ok;
 }
 
-bool SharedMemoryQueue::try_dequeue(void* message, size_t& size) {
-    if (!shared_data_) return false;
-
-    scoped_lock<interprocess_mutex> lock(shared_data_->mutex, try_to_lock);
-    if (!lock.owns()) return false;
-
-    if (empty()) return false;
+void SharedMemoryQueue::waitNotEmpty(int timeout_us) {
+    if (!shared_data_) return;
 
-    size_t tail = shared_data_->tail.load();
-    char* slot = shared_data_->data + (tail * message_size_);
-
-    // Read message size and data
-    size_t msg_size = *reinterpret_cast<size_t*>(slot);
-    if (msg_size + sizeof(size_t) > message_size_) {
-        std::cerr << "SharedMemoryQueue: corrupt message size (" << msg_size << " bytes)" << std::endl;
-        shared_data_->tail.store((tail + 1) % capacity_);
-        shared_data_->not_full.notify_one();
-        return false;
+    shared_data_->consumer_parked.store(1, std::memory_order_seq_cst);
+    // Re-check after announcing the park so a racing publish cannot be missed:
+    // either we see the message here, or the producer sees the flag and wakes
+    if (!empty()) {
+        shared_data_->consumer_parked.store(0, std::memory_order_relaxed);
+        return;
     }
-    std::memcpy(message, slot + sizeof(size_t), msg_size);
-    size = msg_size;
 
-    shared_data_->tail.store((tail + 1) % capacity_);
-    shared_data_->not_full.notify_one();
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = timeout_us / 1000000;
+    ts.tv_nsec = (timeout_us % 1000000) * 1000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&shared_data_->consumer_parked),
+            FUTEX_WAIT, 1, &ts, nullptr, 0);
+    shared_data_->consumer_parked.store(0, std::memory_order_relaxed);
+#else
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(timeout_us, 2000)));
+    shared_data_->consumer_parked.store(0, std::memory_order_relaxed);
+#endif
+}
 
-    return true;
+void SharedMemoryQueue::wakeConsumer() {
+    if (shared_data_->consumer_parked.load(std::memory_order_seq_cst) == 1) {
+        shared_data_->consumer_parked.store(0, std::memory_order_relaxed);
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&shared_data_->consumer_parked),
+                FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#endif
+    }
 }
 
 size_t SharedMemoryQueue::size() const {
     if (!shared_data_) return 0;
 
-    size_t head = shared_data_->head.load();
-    size_t tail = shared_data_->tail.load();
-
-    if (head >= tail) {
-        return head - tail;
-    } else {
-        return capacity_ + head - tail;
-    }
+    uint64_t head = shared_data_->head.load(std::memory_order_acquire);
+    uint64_t tail = shared_data_->tail.load(std::memory_order_acquire);
+    return head > tail ? static_cast<size_t>(head - tail) : 0;
 }
 
 bool SharedMemoryQueue::full() const {
-    return size() == capacity_ - 1; // Leave one slot empty to distinguish full from empty
+    return size() >= capacity_;
 }
 
 void SharedMemoryQueue::remove(const std::string& name) {
@@ -287,6 +340,27 @@ bool SharedMemoryOrderClient::submitOrder(const std::string& order_id, const std
     return queue_->enqueue(message.data(), message_size);
 }
 
+bool SharedMemoryOrderClient::submitOrderFast(uint64_t client_order_id, uint16_t symbol_id,
+                                              uint8_t side, uint8_t order_type,
+                                              int64_t quantity, int64_t price_cents) {
+    if (!queue_) return false;
+
+    WireOrder wire{};
+    wire.message_length = sizeof(WireOrder);
+    wire.body.type = WIRE_ORDER_TYPE;
+    wire.body.flags = WIRE_ORDER_FLAGS;
+    wire.body.side = side;
+    wire.body.order_type = order_type;
+    wire.body.symbol_id = symbol_id;
+    wire.body.client_order_id = client_order_id;
+    wire.body.quantity = quantity;
+    wire.body.price_cents = price_cents;
+    wire.body.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    return queue_->enqueue(&wire, sizeof(wire));
+}
+
 // SharedMemoryOrderServer implementation
 SharedMemoryOrderServer::SharedMemoryOrderServer(const std::string& shm_name, StockExchange* exchange,
                                                AuthenticationManager* auth_manager)
@@ -346,6 +420,41 @@ void SharedMemoryOrderServer::processOrders() {
     while (running_.load()) {
         size_t message_size = 0;
         if (queue_->try_dequeue(buffer.data(), message_size)) {
+            // Fast path: fixed 64-byte WireOrder records (see WireProtocol.h).
+            // The shm segment is a local trust boundary, so fast orders are
+            // attributed to the configured automation user instead of
+            // carrying a per-message auth token.
+            if (message_size == sizeof(WireOrder)) {
+                const WireOrder* wire = reinterpret_cast<const WireOrder*>(buffer.data());
+                if (wire->body.type == WIRE_ORDER_TYPE && wire->body.flags == WIRE_ORDER_FLAGS) {
+                    static const char* trusted_user = std::getenv("AUREX_SHM_TRUSTED_USER");
+                    if (!trusted_user) {
+                        std::cerr << "SharedMemory: fast order received but AUREX_SHM_TRUSTED_USER is not set, dropping" << std::endl;
+                        continue;
+                    }
+
+                    Order core_order;
+                    std::string error = decodeWireOrder(wire->body, trusted_user, core_order);
+                    if (!error.empty()) {
+                        std::cerr << "SharedMemory: fast order rejected: " << error << std::endl;
+                        continue;
+                    }
+
+                    // Same 1-in-1000 latency sampling as the v1 paths
+                    static std::atomic<uint64_t> fast_sample_counter{0};
+                    if (fast_sample_counter.fetch_add(1, std::memory_order_relaxed) % 1000 == 0) {
+                        core_order.ingress_tsc = engine_clock::cycles();
+                    }
+
+                    std::string result = exchange_->submitOrder(core_order.symbol, core_order);
+                    if (result != "accepted") {
+                        std::cerr << "SharedMemory: Order " << core_order.order_id << " rejected: " << result << std::endl;
+                    }
+                    EngineTelemetry::instance().recordOrder();
+                    continue;
+                }
+            }
+
             if (message_size >= sizeof(SharedOrderMessage)) {
                 SharedOrderMessage* order_msg = reinterpret_cast<SharedOrderMessage*>(buffer.data());
 
@@ -402,20 +511,14 @@ void SharedMemoryOrderServer::processOrders() {
                     continue;
                 }
 
-                ConnectionId conn_id = automation_connection_id_.fetch_sub(1);
-                AuthResult auth_result = auth_manager_->authenticateConnection(conn_id, auth_token);
+                // Connection-less token check: served from the validated-token
+                // cache in steady state, so repeated orders on the same token
+                // no longer cost a Redis round trip (or a throwaway session).
+                UserId authenticated_user;
+                AuthResult auth_result = auth_manager_->authenticateToken(auth_token, authenticated_user);
 
-                if (auth_result != AuthResult::SUCCESS && auth_result != AuthResult::ALREADY_AUTHENTICATED) {
+                if (auth_result != AuthResult::SUCCESS) {
                     std::cerr << "SharedMemory: token authentication failed for order " << order_id << std::endl;
-                    auth_manager_->removeSession(conn_id);
-                    continue;
-                }
-
-                UserId authenticated_user = auth_manager_->getUserId(conn_id);
-                auth_manager_->removeSession(conn_id);
-
-                if (authenticated_user.empty()) {
-                    std::cerr << "SharedMemory: authenticated user not found for order " << order_id << std::endl;
                     continue;
                 }
 
@@ -437,6 +540,18 @@ void SharedMemoryOrderServer::processOrders() {
                     static_cast<int64_t>(order_msg->timestamp_ms)
                 };
 
+                // Resolve interned handles once at the edge (see InternTable.h)
+                core_order.user_handle = static_cast<UserHandle>(InternTable::users().intern(authenticated_user));
+                core_order.symbol_handle = static_cast<SymbolHandle>(InternTable::symbols().intern(symbol));
+                core_order.order_seq = nextOrderSequence();
+
+                // Sample 1-in-1000 orders for per-stage latency percentiles,
+                // matching the TCP path's sampling rate
+                static std::atomic<uint64_t> order_sample_counter{0};
+                if (order_sample_counter.fetch_add(1, std::memory_order_relaxed) % 1000 == 0) {
+                    core_order.ingress_tsc = engine_clock::cycles();
+                }
+
                 // CRITICAL FIX: Check the result of submitOrder to detect rejections
                 // Previously we ignored the return value, causing silent failures for
                 // shared memory clients (risk rejections, validation errors, etc.)
@@ -453,7 +568,10 @@ void SharedMemoryOrderServer::processOrders() {
             if (!running_.load()) {
                 break;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            // Park on the shared futex word instead of sleeping: a producer
+            // publish wakes us immediately, and the timeout keeps the
+            // running_ check responsive for shutdown
+            queue_->waitNotEmpty(2000);
         }
     }
 
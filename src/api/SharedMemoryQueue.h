@@ -11,10 +11,8 @@
 #include <thread>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/mapped_region.hpp>
-#include <boost/interprocess/sync/interprocess_mutex.hpp>
-#include <boost/interprocess/sync/interprocess_condition.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <cstring>
@@ -22,25 +20,38 @@
 #include "../core_engine/StockExchange.h"
 #include "AuthenticationManager.h"
 
-// Shared memory ring buffer for ultra-low latency order submission
+// Shared memory ring buffer for ultra-low latency order submission.
+//
+// Lock-free layout (v2): a bounded ring with one sequence word per slot,
+// following the same atomic head/tail discipline as the in-process queues in
+// LockFreeQueue.h. Producers claim a slot with a single CAS on head and
+// publish by bumping the slot sequence; the single consumer releases slots by
+// bumping the sequence a full lap ahead. No interprocess mutex, no condition
+// variables, no kernel transitions on the fast path. An optional futex doze
+// parks the idle consumer; producers only touch the futex when the parked
+// flag is set, so a busy feed never pays the syscall.
 class SharedMemoryQueue {
 private:
     struct SharedData {
-        // Ring buffer metadata
-        std::atomic<size_t> head{0};
-        std::atomic<size_t> tail{0};
-        size_t capacity;
-        size_t message_size;
-
-        // Synchronization
-        boost::interprocess::interprocess_mutex mutex;
-        boost::interprocess::interprocess_condition not_empty;
-        boost::interprocess::interprocess_condition not_full;
-
-        // Ring buffer data follows
+        uint32_t magic;      // Layout guard so stale clients refuse to attach
+        uint32_t version;
+        size_t capacity;     // Slot count, power of two
+        size_t message_size; // Payload bytes per slot (incl. size prefix)
+        size_t slot_stride;  // Sequence word + payload, cache-line padded
+
+        // Producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        // Futex word: 1 while the consumer is parked waiting for messages
+        alignas(64) std::atomic<uint32_t> consumer_parked{0};
+
+        // Slot array follows: per-slot {atomic<uint64_t> sequence, payload}
         char data[0];
     };
 
+    static constexpr uint32_t SHM_MAGIC = 0x41555251; // "AURQ"
+    static constexpr uint32_t SHM_VERSION = 2;
+
     std::string shm_name_;
     boost::interprocess::shared_memory_object shm_;
     boost::interprocess::mapped_region region_;
@@ -49,6 +60,10 @@ private:
     size_t capacity_;
     size_t message_size_;
 
+    std::atomic<uint64_t>* slotSequence(uint64_t pos) const;
+    char* slotPayload(uint64_t pos) const;
+    void wakeConsumer();
+
 public:
     // Server-side constructor (creates shared memory)
     SharedMemoryQueue(const std::string& name, size_t capacity, size_t message_size);
@@ -66,6 +81,11 @@ public:
     bool dequeue(void* message, size_t& size);
     bool try_dequeue(void* message, size_t& size);
 
+    // Consumer-side doze: park on the shared futex word until a producer
+    // publishes or the timeout elapses. Falls back to a short sleep where
+    // futexes are unavailable.
+    void waitNotEmpty(int timeout_us);
+
     // Status
     bool is_connected() const { return shared_data_ != nullptr; }
     size_t size() const;
@@ -110,6 +130,13 @@ public:
                      const std::string& symbol, uint8_t side, uint8_t order_type,
                      uint64_t quantity, double price, const std::string& auth_token);
 
+    // Fast path: fixed 64-byte WireOrder record, fixed-point price, numeric
+    // order id. Requires the server to run with AUREX_SHM_TRUSTED_USER set;
+    // the order is attributed to that user (see WireProtocol.h).
+    bool submitOrderFast(uint64_t client_order_id, uint16_t symbol_id,
+                         uint8_t side, uint8_t order_type,
+                         int64_t quantity, int64_t price_cents);
+
     bool isConnected() const { return queue_ && queue_->is_connected(); }
 };
 
@@ -120,7 +147,6 @@ private:
     std::string shm_name_;
     StockExchange* exchange_;
     AuthenticationManager* auth_manager_;
-    std::atomic<ConnectionId> automation_connection_id_{-1};
     std::thread worker_thread_;
     std::atomic<bool> running_{false};
 
@@ -8,9 +8,11 @@
  */
 
 #include "TCPServer.h"
+#include "common/EngineConfig.h"
 #include "common/EngineTelemetry.h"
 #include "common/EngineLogging.h"
 #include <iostream>
+#include <cstdlib>
 #include <cstring>
 #include <chrono>
 #include <condition_variable>
@@ -27,6 +29,7 @@
 #include <mutex>
 #include <sstream>
 #include "AuthenticationManager.h"
+#include "WireProtocol.h"
 
 // CPU frequency calibration for RDTSC timing
 static uint64_t get_cpu_freq_hz() {
@@ -98,12 +101,19 @@ double uint64_to_double(uint64_t value) {
 }
 
 // TCPConnection implementation
-TCPConnection::TCPConnection(boost::asio::ssl::stream<boost::asio::ip::tcp::socket> socket, 
-                             StockExchange* exchange, 
-                             AuthenticationManager* auth_manager)
-    : ssl_socket_(std::move(socket)), exchange_(exchange), auth_manager_(auth_manager) {
+TCPConnection::TCPConnection(boost::asio::ssl::stream<boost::asio::ip::tcp::socket> socket,
+                             StockExchange* exchange,
+                             AuthenticationManager* auth_manager,
+                             bool coroutine_mode,
+                             bool plaintext)
+    : ssl_socket_(std::move(socket)), exchange_(exchange), auth_manager_(auth_manager),
+      coroutine_mode_(coroutine_mode), plaintext_(plaintext) {
     // Generate unique connection ID (using socket native handle or a counter)
     connection_id_ = static_cast<ConnectionId>(ssl_socket_.lowest_layer().native_handle());
+
+    // Reserve once so readBody's resize never reallocates on the hot path
+    // (frames are capped at the header buffer size)
+    message_buffer_.reserve(buffer_.size());
 }
 
 TCPConnection::~TCPConnection() {
@@ -115,7 +125,26 @@ TCPConnection::~TCPConnection() {
 
 void TCPConnection::start() {
     connected_.store(true);
-    
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    if (coroutine_mode_) {
+        // One coroutine owns the whole session: handshake, then the framed
+        // read loop. shared_from_this keeps the connection alive for its run.
+        auto self = shared_from_this();
+        boost::asio::co_spawn(ssl_socket_.get_executor(),
+            [self]() { return self->runSession(); },
+            boost::asio::detached);
+        return;
+    }
+#endif
+
+    // Trusted-port connections skip the handshake entirely and go straight
+    // to the framed read loop over the raw socket
+    if (plaintext_) {
+        readHeader();
+        return;
+    }
+
     // Perform SSL/TLS handshake before reading data
     auto self = shared_from_this();
     ssl_socket_.async_handshake(boost::asio::ssl::stream_base::server,
@@ -135,25 +164,94 @@ void TCPConnection::stop() {
     if (!connected_.exchange(false)) return;
 
     boost::system::error_code ec;
-    
-    // Shutdown SSL stream first
-    ssl_socket_.async_shutdown([](const boost::system::error_code&) {
-        // SSL shutdown complete (ignore errors during shutdown)
-    });
-    
+
+    // Shutdown SSL stream first (no TLS session exists on the trusted port)
+    if (!plaintext_) {
+        ssl_socket_.async_shutdown([](const boost::system::error_code&) {
+            // SSL shutdown complete (ignore errors during shutdown)
+        });
+    }
+
     // Then shutdown the underlying socket
     ssl_socket_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
     ssl_socket_.lowest_layer().close(ec);
 }
 
+// Validates the 4-byte length prefix sitting in buffer_ and yields the body
+// length. Shared by the callback chain and the coroutine loop so frame
+// sanity checks cannot drift between the two transports.
+bool TCPConnection::decodeFrameLength(size_t& body_length) {
+    uint32_t message_length;
+    std::memcpy(&message_length, buffer_.data(), sizeof(uint32_t));
+    message_length = ntohl(message_length); // Network to host byte order
+
+    // Guard against malformed frames: must hold at least the length header
+    // plus a message type, and must fit the fixed read buffer
+    if (message_length < sizeof(uint32_t) + sizeof(MessageType) ||
+        message_length > buffer_.size()) {
+        std::cerr << "TCP Connection: Invalid message length: " << message_length << std::endl;
+        return false;
+    }
+
+    // The message_length includes the 4-byte length header, so subtract it
+    body_length = message_length - sizeof(uint32_t);
+    return true;
+}
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+boost::asio::awaitable<void> TCPConnection::runSession() {
+    try {
+        if (!plaintext_) {
+            co_await ssl_socket_.async_handshake(boost::asio::ssl::stream_base::server,
+                                                 boost::asio::use_awaitable);
+            ENGINE_LOG_DEV(std::cout << "TCP Connection: SSL handshake successful for connection "
+                                     << connection_id_ << std::endl;);
+        }
+
+        while (connected_.load()) {
+            auto header = boost::asio::buffer(buffer_.data(), sizeof(uint32_t));
+            if (plaintext_) {
+                co_await boost::asio::async_read(ssl_socket_.next_layer(), header,
+                                                 boost::asio::use_awaitable);
+            } else {
+                co_await boost::asio::async_read(ssl_socket_, header,
+                                                 boost::asio::use_awaitable);
+            }
+
+            size_t body_length = 0;
+            if (!decodeFrameLength(body_length)) {
+                handleError(boost::asio::error::make_error_code(boost::asio::error::invalid_argument));
+                co_return;
+            }
+
+            message_buffer_.resize(body_length);
+            auto body = boost::asio::buffer(message_buffer_.data(), body_length);
+            if (plaintext_) {
+                co_await boost::asio::async_read(ssl_socket_.next_layer(), body,
+                                                 boost::asio::use_awaitable);
+            } else {
+                co_await boost::asio::async_read(ssl_socket_, body,
+                                                 boost::asio::use_awaitable);
+            }
+
+            processMessage(message_buffer_);
+        }
+    } catch (const boost::system::system_error& e) {
+        handleError(e.code());
+    } catch (const std::exception& e) {
+        std::cerr << "TCP Connection: Exception in session coroutine: " << e.what() << std::endl;
+        stop();
+    }
+}
+#endif
+
 void TCPConnection::readHeader() {
     if (!connected_.load()) return;
 
     auto self = shared_from_this();
-    
+
     try {
-        boost::asio::async_read(ssl_socket_,
-            boost::asio::buffer(buffer_.data(), sizeof(uint32_t)),
+        auto handler =
             [this, self](const boost::system::error_code& error, std::size_t bytes_transferred) {
                 try {
                     if (error) {
@@ -166,23 +264,8 @@ void TCPConnection::readHeader() {
                         return;
                     }
 
-                    uint32_t message_length;
-                    std::memcpy(&message_length, buffer_.data(), sizeof(uint32_t));
-                    message_length = ntohl(message_length); // Network to host byte order
-
-                    // Guard against malformed frames that are smaller than the header itself
-                    if (message_length < sizeof(uint32_t) + sizeof(MessageType)) {
-                        std::cerr << "TCP Connection: Invalid message length header: " << message_length << std::endl;
-                        handleError(boost::asio::error::make_error_code(boost::asio::error::invalid_argument));
-                        return;
-                    }
-
-                    // The message_length includes the 4-byte length header, so subtract it
-                    size_t body_length = message_length - sizeof(uint32_t);
-
-                    if (message_length > buffer_.size() || message_length > 8192 || body_length < sizeof(MessageType)) {
-                        std::cerr << "TCP Connection: Invalid message length: " << message_length 
-                                 << " (body: " << body_length << ")" << std::endl;
+                    size_t body_length = 0;
+                    if (!decodeFrameLength(body_length)) {
                         handleError(boost::asio::error::make_error_code(boost::asio::error::invalid_argument));
                         return;
                     }
@@ -195,7 +278,14 @@ void TCPConnection::readHeader() {
                     std::cerr << "TCP Connection: Unknown exception in readHeader callback" << std::endl;
                     stop();
                 }
-            });
+            };
+
+        auto header = boost::asio::buffer(buffer_.data(), sizeof(uint32_t));
+        if (plaintext_) {
+            boost::asio::async_read(ssl_socket_.next_layer(), header, std::move(handler));
+        } else {
+            boost::asio::async_read(ssl_socket_, header, std::move(handler));
+        }
     } catch (const std::exception& e) {
         std::cerr << "TCP Connection: Exception in readHeader: " << e.what() << std::endl;
         stop();
@@ -212,8 +302,7 @@ void TCPConnection::readBody(size_t expected_length) {
         message_buffer_.resize(expected_length);
         auto self = shared_from_this();
 
-        boost::asio::async_read(ssl_socket_,
-            boost::asio::buffer(message_buffer_.data(), expected_length),
+        auto handler =
             [this, self, expected_length](const boost::system::error_code& error, std::size_t bytes_transferred) {
                 try {
                     if (error) {
@@ -237,7 +326,14 @@ void TCPConnection::readBody(size_t expected_length) {
                     std::cerr << "TCP Connection: Unknown exception in readBody callback" << std::endl;
                     stop();
                 }
-            });
+            };
+
+        auto body = boost::asio::buffer(message_buffer_.data(), expected_length);
+        if (plaintext_) {
+            boost::asio::async_read(ssl_socket_.next_layer(), body, std::move(handler));
+        } else {
+            boost::asio::async_read(ssl_socket_, body, std::move(handler));
+        }
     } catch (const std::exception& e) {
         std::cerr << "TCP Connection: Exception in readBody: " << e.what() << std::endl;
         stop();
@@ -272,7 +368,7 @@ void TCPConnection::processMessage(const std::vector<char>& data) {
             if (!auth_manager_->isAuthenticated(connection_id_)) {
                 std::cerr << "TCP Connection: Order received from unauthenticated connection " << connection_id_ << std::endl;
                 // Send rejection response
-                std::vector<char> response(sizeof(BinaryOrderResponse) + 20);
+                std::vector<char> response = acquireResponseBuffer(sizeof(BinaryOrderResponse) + 20);
                 BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
                 resp->message_length = htonl(sizeof(BinaryOrderResponse) + 20);
                 resp->type = MessageType::ORDER_RESPONSE;
@@ -280,17 +376,34 @@ void TCPConnection::processMessage(const std::vector<char>& data) {
                 resp->accepted = 0;
                 resp->message_len = htonl(20);
                 std::memcpy(response.data() + sizeof(BinaryOrderResponse), "Not authenticated", 17);
-                sendResponse(response);
+                sendResponse(std::move(response));
                 return;
             }
             processOrderRequest(data);
             break;
-            
+
+        case MessageType::SUBMIT_ORDER_FAST:
+            if (!auth_manager_->isAuthenticated(connection_id_)) {
+                std::cerr << "TCP Connection: Fast order received from unauthenticated connection " << connection_id_ << std::endl;
+                std::vector<char> response = acquireResponseBuffer(sizeof(BinaryOrderResponse) + 20);
+                BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
+                resp->message_length = htonl(sizeof(BinaryOrderResponse) + 20);
+                resp->type = MessageType::ORDER_RESPONSE;
+                resp->order_id_len = htonl(0);
+                resp->accepted = 0;
+                resp->message_len = htonl(20);
+                std::memcpy(response.data() + sizeof(BinaryOrderResponse), "Not authenticated", 17);
+                sendResponse(std::move(response));
+                return;
+            }
+            processFastOrderRequest(data);
+            break;
+
         case MessageType::HEARTBEAT:
             // Update last activity and send heartbeat ack
             auth_manager_->updateLastActivity(connection_id_);
             {
-                std::vector<char> response(sizeof(BinaryOrderResponse) + 1);
+                std::vector<char> response = acquireResponseBuffer(sizeof(BinaryOrderResponse) + 1);
                 BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
                 resp->message_length = htonl(sizeof(BinaryOrderResponse) + 1);
                 resp->type = MessageType::HEARTBEAT_ACK;
@@ -298,7 +411,7 @@ void TCPConnection::processMessage(const std::vector<char>& data) {
                 resp->accepted = 1;
                 resp->message_len = htonl(1);
                 response[sizeof(BinaryOrderResponse)] = 'P'; // Pong
-                sendResponse(response);
+                sendResponse(std::move(response));
             }
             break;
             
@@ -315,14 +428,37 @@ void TCPConnection::processMessage(const std::vector<char>& data) {
     }
 }
 
-void TCPConnection::sendResponse(const std::vector<char>& response, uint64_t start_cycles) {
+std::vector<char> TCPConnection::acquireResponseBuffer(size_t size) {
+    std::vector<char> buffer;
+    {
+        std::lock_guard<std::mutex> lock(response_pool_mutex_);
+        if (!response_pool_.empty()) {
+            buffer = std::move(response_pool_.back());
+            response_pool_.pop_back();
+        }
+    }
+    buffer.resize(size);  // Retains capacity from previous use
+    return buffer;
+}
+
+void TCPConnection::releaseResponseBuffer(std::vector<char>&& buffer) {
+    std::lock_guard<std::mutex> lock(response_pool_mutex_);
+    if (response_pool_.size() < MAX_POOLED_RESPONSES) {
+        response_pool_.push_back(std::move(buffer));
+    }
+}
+
+void TCPConnection::sendResponse(std::vector<char> response, uint64_t start_cycles) {
     if (!connected_.load()) return;
 
     try {
         auto self = shared_from_this();
-        boost::asio::async_write(ssl_socket_,
-            boost::asio::buffer(response.data(), response.size()),
-            [this, self, start_cycles](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+        // The completion handler owns the bytes until the write finishes,
+        // then recycles them into the response pool
+        auto buf = std::make_shared<std::vector<char>>(std::move(response));
+        auto handler =
+            [this, self, buf, start_cycles](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+                releaseResponseBuffer(std::move(*buf));
                 try {
                     if (error) {
                         handleError(error);
@@ -361,7 +497,14 @@ void TCPConnection::sendResponse(const std::vector<char>& response, uint64_t sta
                 } catch (...) {
                     std::cerr << "TCP Connection: Unknown exception in sendResponse callback" << std::endl;
                 }
-            });
+            };
+
+        auto payload = boost::asio::buffer(buf->data(), buf->size());
+        if (plaintext_) {
+            boost::asio::async_write(ssl_socket_.next_layer(), payload, std::move(handler));
+        } else {
+            boost::asio::async_write(ssl_socket_, payload, std::move(handler));
+        }
     } catch (const std::exception& e) {
         std::cerr << "TCP Connection: Exception in sendResponse: " << e.what() << std::endl;
         stop();
@@ -452,7 +595,7 @@ void TCPConnection::processLoginRequest(const std::vector<char>& data) {
         
         // Prepare response
         size_t response_size = sizeof(BinaryLoginResponse) + message.size();
-        std::vector<char> response(response_size);
+        std::vector<char> response = acquireResponseBuffer(response_size);
         
         BinaryLoginResponse* resp = reinterpret_cast<BinaryLoginResponse*>(response.data());
         resp->message_length = htonl(response_size);
@@ -463,7 +606,7 @@ void TCPConnection::processLoginRequest(const std::vector<char>& data) {
         // Copy message
         std::memcpy(response.data() + sizeof(BinaryLoginResponse), message.data(), message.size());
         
-        sendResponse(response);
+        sendResponse(std::move(response));
         
         if (!success) {
             // Close connection on failed authentication
@@ -551,7 +694,7 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
             std::string message = "Insufficient buying power";
             
             size_t response_size = sizeof(BinaryOrderResponse) + order_id.size() + message.size();
-            std::vector<char> response(response_size);
+            std::vector<char> response = acquireResponseBuffer(response_size);
 
             BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
             resp->message_length = htonl(response_size);
@@ -566,7 +709,7 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
             string_data += order_id.size();
             std::memcpy(string_data, message.data(), message.size());
 
-            sendResponse(response);
+            sendResponse(std::move(response));
             return;
         }
     }
@@ -583,10 +726,19 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
         static_cast<int64_t>(ntohll(request->timestamp_ms))
     };
 
+    // Resolve interned handles once at the edge so the matching path never
+    // compares the string identifiers
+    core_order.user_handle = static_cast<UserHandle>(InternTable::users().intern(authenticated_user_id));
+    core_order.symbol_handle = static_cast<SymbolHandle>(InternTable::symbols().intern(symbol));
+    core_order.order_seq = nextOrderSequence();
+
     // Submit order with timing (only when sampling)
     uint64_t engine_start_cycles = 0;
     if (should_measure) {
         engine_start_cycles = get_cycles();
+        // Per-stage stamps: the matching thread measures queue wait and match
+        // time for sampled orders (see EngineTelemetry)
+        core_order.ingress_tsc = engine_start_cycles;
     }
     
     std::string result = exchange_->submitOrder(symbol, core_order);
@@ -631,7 +783,7 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
     std::string message = accepted ? "Order accepted" : result;
 
     size_t response_size = sizeof(BinaryOrderResponse) + order_id.size() + message.size();
-    std::vector<char> response(response_size);
+    std::vector<char> response = acquireResponseBuffer(response_size);
 
     BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
     resp->message_length = htonl(response_size);
@@ -646,7 +798,7 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
     string_data += order_id.size();
     std::memcpy(string_data, message.data(), message.size());
 
-    sendResponse(response, should_measure ? total_start_cycles : 0);
+    sendResponse(std::move(response), should_measure ? total_start_cycles : 0);
     
     } catch (const std::exception& e) {
         std::cerr << "TCP Connection: Exception in processOrderRequest: " << e.what() << std::endl;
@@ -657,15 +809,88 @@ void TCPConnection::processOrderRequest(const std::vector<char>& data) {
     }
 }
 
+void TCPConnection::processFastOrderRequest(const std::vector<char>& data) {
+    try {
+
+    // Fixed-size body: no string lengths to validate, no copies
+    if (data.size() != sizeof(WireOrderBody)) {
+        std::cerr << "TCP Connection: Fast order with wrong body size (" << data.size() << " bytes)" << std::endl;
+        return;
+    }
+    const WireOrderBody* wire = reinterpret_cast<const WireOrderBody*>(data.data());
+
+    UserId authenticated_user_id = auth_manager_->getUserId(connection_id_);
+    std::string order_id = std::to_string(wire->client_order_id);
+
+    std::string result;
+    Order core_order;
+    if (authenticated_user_id.empty()) {
+        result = "rejected: user session not found";
+    } else {
+        result = decodeWireOrder(*wire, authenticated_user_id, core_order);
+        if (!result.empty()) {
+            result = "rejected: " + result;
+        }
+    }
+
+    uint64_t total_start_cycles = 0;
+    if (result.empty()) {
+        // Same 1-in-1000 latency sampling as the v1 path
+        static std::atomic<uint64_t> fast_order_counter{0};
+        bool should_measure = (fast_order_counter.fetch_add(1, std::memory_order_relaxed) % 1000 == 0);
+        if (should_measure) {
+            total_start_cycles = get_cycles();
+            core_order.ingress_tsc = total_start_cycles;
+        }
+
+        std::string submit_result = exchange_->submitOrder(core_order.symbol, core_order);
+        if (should_measure) {
+            long long engine_us = (get_cycles() - total_start_cycles) * 1000000LL / get_cpu_freq_hz();
+            EngineTelemetry::instance().recordOrder(engine_us);
+        } else {
+            EngineTelemetry::instance().recordOrder();
+        }
+        result = submit_result;
+    }
+
+    bool accepted = (result == "accepted");
+    std::string message = accepted ? "Order accepted" : result;
+
+    size_t response_size = sizeof(BinaryOrderResponse) + order_id.size() + message.size();
+    std::vector<char> response = acquireResponseBuffer(response_size);
+
+    BinaryOrderResponse* resp = reinterpret_cast<BinaryOrderResponse*>(response.data());
+    resp->message_length = htonl(response_size);
+    resp->type = MessageType::ORDER_RESPONSE;
+    resp->order_id_len = htonl(order_id.size());
+    resp->accepted = accepted ? 1 : 0;
+    resp->message_len = htonl(message.size());
+
+    char* string_data = response.data() + sizeof(BinaryOrderResponse);
+    std::memcpy(string_data, order_id.data(), order_id.size());
+    string_data += order_id.size();
+    std::memcpy(string_data, message.data(), message.size());
+
+    sendResponse(std::move(response), total_start_cycles);
+
+    } catch (const std::exception& e) {
+        std::cerr << "TCP Connection: Exception in processFastOrderRequest: " << e.what() << std::endl;
+        // Don't stop connection on order processing error, just skip this order
+    } catch (...) {
+        std::cerr << "TCP Connection: Unknown exception in processFastOrderRequest" << std::endl;
+    }
+}
+
 // TCPServer implementation
 TCPServer::TCPServer(const std::string& address, uint16_t port, 
                      StockExchange* exchange, 
                      AuthenticationManager* auth_manager,
                      const std::string& cert_file,
                      const std::string& key_file)
-    : acceptor_(io_context_), 
+    : acceptor_(io_context_),
       ssl_context_(boost::asio::ssl::context::tlsv13),
-      exchange_(exchange), 
+      trusted_acceptor_(io_context_),
+      exchange_(exchange),
       auth_manager_(auth_manager) {
     
     try {
@@ -693,6 +918,17 @@ TCPServer::TCPServer(const std::string& address, uint16_t port,
         throw std::runtime_error("SSL initialization failed: " + std::string(e.what()));
     }
     
+    // Optional coroutine transport (see TCPConnection doc comment)
+    const char* coro_env = std::getenv("AUREX_TCP_COROUTINES");
+    coroutine_mode_ = (coro_env != nullptr && std::string(coro_env) != "0");
+#ifndef BOOST_ASIO_HAS_CO_AWAIT
+    if (coroutine_mode_) {
+        std::cerr << "TCP Server: AUREX_TCP_COROUTINES set but asio has no coroutine support; "
+                  << "using callback transport" << std::endl;
+        coroutine_mode_ = false;
+    }
+#endif
+
     boost::system::error_code ec;
     auto addr = boost::asio::ip::make_address(address, ec);
     if (ec) {
@@ -727,7 +963,40 @@ TCPServer::TCPServer(const std::string& address, uint16_t port,
         std::cerr << "TCP Server: Failed to listen: " << ec.message() << std::endl;
         throw std::runtime_error("Failed to listen: " + ec.message());
     }
-    
+
+    // Optional plaintext listener for colocated trusted clients: same binary
+    // protocol, no TLS handshake or record encryption. Must only ever be
+    // exposed on a trusted network segment.
+    trusted_port_ = engine_config::tcpTrustedPort();
+    if (trusted_port_ != 0) {
+        trusted_acceptor_.open(boost::asio::ip::tcp::v4(), ec);
+        if (ec) {
+            std::cerr << "TCP Server: Failed to open trusted acceptor: " << ec.message() << std::endl;
+            throw std::runtime_error("Failed to open trusted acceptor: " + ec.message());
+        }
+
+        trusted_acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), ec);
+        if (ec) {
+            std::cerr << "TCP Server: Warning - Failed to set reuse_address on trusted acceptor: " << ec.message() << std::endl;
+        }
+
+        boost::asio::ip::tcp::endpoint trusted_endpoint(addr, trusted_port_);
+        trusted_acceptor_.bind(trusted_endpoint, ec);
+        if (ec) {
+            std::cerr << "TCP Server: Failed to bind trusted port " << trusted_port_ << " - " << ec.message() << std::endl;
+            throw std::runtime_error("Failed to bind trusted port " + std::to_string(trusted_port_) + " - " + ec.message());
+        }
+
+        trusted_acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+        if (ec) {
+            std::cerr << "TCP Server: Failed to listen on trusted port: " << ec.message() << std::endl;
+            throw std::runtime_error("Failed to listen on trusted port: " + ec.message());
+        }
+
+        std::cout << "⚠️  Plaintext trusted port " << trusted_port_ << " enabled - "
+                  << "restrict it to the colocated network, traffic is NOT encrypted" << std::endl;
+    }
+
     ENGINE_LOG_DEV(std::cout << "TCP Server: Successfully initialized on " << address << ":" << port << std::endl;);
 }
 
@@ -751,6 +1020,9 @@ void TCPServer::start() {
         // Start accepting connections BEFORE starting worker threads
     ENGINE_LOG_DEV(std::cout << "TCP Server: Starting to accept connections" << std::endl;);
         acceptConnection();
+        if (trusted_port_ != 0) {
+            acceptTrustedConnection();
+        }
 
         // Start worker threads
         unsigned int num_threads = std::thread::hardware_concurrency();
@@ -816,9 +1088,14 @@ void TCPServer::acceptConnection() {
                                          << ssl_socket->lowest_layer().remote_endpoint().address().to_string()
                                          << ":" << ssl_socket->lowest_layer().remote_endpoint().port() 
                                          << " (SSL handshake pending...)" << std::endl;);
-                           
-                auto connection = std::make_shared<TCPConnection>(std::move(*ssl_socket), exchange_, auth_manager_);
-                  
+
+                // Orders are tiny request/response frames; never let Nagle
+                // hold a fill confirmation back waiting for more payload
+                boost::system::error_code nodelay_ec;
+                ssl_socket->lowest_layer().set_option(boost::asio::ip::tcp::no_delay(true), nodelay_ec);
+
+                auto connection = std::make_shared<TCPConnection>(std::move(*ssl_socket), exchange_, auth_manager_, coroutine_mode_);
+
                 // CRITICAL FIX: Set cleanup callback so connection can remove itself from map
                 // This prevents stale connections from persisting and enables proper session cleanup
                 ConnectionId conn_id = connection->getConnectionId();
@@ -842,6 +1119,52 @@ void TCPServer::acceptConnection() {
         });
 }
 
+void TCPServer::acceptTrustedConnection() {
+    if (!running_.load()) return;
+
+    // The connection class reads through the ssl stream's next_layer() in
+    // plaintext mode, so the wrapper is constructed but never handshaken
+    auto ssl_socket = std::make_shared<boost::asio::ssl::stream<boost::asio::ip::tcp::socket>>(
+        io_context_, ssl_context_);
+
+    trusted_acceptor_.async_accept(ssl_socket->lowest_layer(),
+        [this, ssl_socket](const boost::system::error_code& error) {
+            if (error) {
+                if (error != boost::asio::error::operation_aborted && running_.load()) {
+                    std::cerr << "TCP Server: Trusted accept error: " << error.message() << std::endl;
+                }
+            } else if (running_.load()) {
+                ENGINE_LOG_DEV(std::cout << "TCP Server: New trusted client connected from "
+                                         << ssl_socket->lowest_layer().remote_endpoint().address().to_string()
+                                         << ":" << ssl_socket->lowest_layer().remote_endpoint().port()
+                                         << " (plaintext)" << std::endl;);
+
+                boost::system::error_code nodelay_ec;
+                ssl_socket->lowest_layer().set_option(boost::asio::ip::tcp::no_delay(true), nodelay_ec);
+
+                auto connection = std::make_shared<TCPConnection>(std::move(*ssl_socket), exchange_, auth_manager_,
+                                                                  coroutine_mode_, /*plaintext=*/true);
+
+                ConnectionId conn_id = connection->getConnectionId();
+                connection->setCleanupCallback([this, conn_id](ConnectionId id) {
+                    std::lock_guard<std::mutex> lock(connections_mutex_);
+                    connections_.erase(std::to_string(id));
+                });
+
+                connection->start();
+
+                {
+                    std::lock_guard<std::mutex> lock(connections_mutex_);
+                    connections_[std::to_string(conn_id)] = connection;
+                }
+            }
+
+            if (running_.load()) {
+                acceptTrustedConnection(); // Continue accepting
+            }
+        });
+}
+
 void TCPServer::workerThread() {
     try {
         io_context_.run();
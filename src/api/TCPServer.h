@@ -32,7 +32,8 @@ enum class MessageType : uint8_t {
     SUBMIT_ORDER = 3,
     ORDER_RESPONSE = 4,
     HEARTBEAT = 5,
-    HEARTBEAT_ACK = 6
+    HEARTBEAT_ACK = 6,
+    SUBMIT_ORDER_FAST = 7  // Fixed 64-byte WireOrder record (WireProtocol.h)
 };
 
 // Binary order request structure (packed for network efficiency)
@@ -78,7 +79,14 @@ struct BinaryOrderResponse {
 };
 #pragma pack(pop)
 
-// TCP connection for handling client sessions (SSL/TLS encrypted)
+// TCP connection for handling client sessions (SSL/TLS encrypted).
+// Two transport modes share the same wire protocol: the classic chained
+// async callbacks, and (AUREX_TCP_COROUTINES=1) a single C++20 coroutine per
+// connection that drives handshake + framed read loop on asio::awaitable —
+// no per-read closure allocations and a flat, exception-based error path.
+// Connections accepted on the trusted-network listener additionally run in
+// plaintext mode: same frames, but I/O goes straight to the underlying
+// socket and no handshake or record encryption happens.
 class TCPConnection : public std::enable_shared_from_this<TCPConnection> {
 private:
     boost::asio::ssl::stream<boost::asio::ip::tcp::socket> ssl_socket_;
@@ -88,31 +96,34 @@ private:
     AuthenticationManager* auth_manager_;
     std::atomic<bool> connected_{true};
     ConnectionId connection_id_;
-    
+    bool coroutine_mode_{false};
+    // Trusted-port connection: skip the handshake and read/write through
+    // ssl_socket_.next_layer() (the stream wrapper is never handshaken)
+    bool plaintext_{false};
+
     // Callback to notify server when connection should be cleaned up
     std::function<void(ConnectionId)> server_cleanup_callback_;
 
-    // For batched responses
-    std::vector<std::vector<char>> pending_responses_;
-    std::mutex response_mutex_;
-
-    // Batching for order processing
-    std::vector<std::vector<char>> pending_orders_;
-    std::mutex batch_mutex_;
-    std::condition_variable batch_cv_;
-    static constexpr size_t MAX_BATCH_SIZE = 64;
-    static constexpr std::chrono::microseconds BATCH_TIMEOUT{100};
+    // Pooled response buffers: a completed write returns its buffer here and
+    // the next response reuses the allocation instead of growing a fresh
+    // std::vector per message. The in-flight buffer is owned by the write's
+    // completion handler, so the bytes stay alive for the whole async_write.
+    std::vector<std::vector<char>> response_pool_;
+    std::mutex response_pool_mutex_;
+    static constexpr size_t MAX_POOLED_RESPONSES = 16;
 
 public:
-    TCPConnection(boost::asio::ssl::stream<boost::asio::ip::tcp::socket> socket, 
-                  StockExchange* exchange, 
-                  AuthenticationManager* auth_manager);
+    TCPConnection(boost::asio::ssl::stream<boost::asio::ip::tcp::socket> socket,
+                  StockExchange* exchange,
+                  AuthenticationManager* auth_manager,
+                  bool coroutine_mode = false,
+                  bool plaintext = false);
     ~TCPConnection();
 
     void start();
     void stop();
     ConnectionId getConnectionId() const { return connection_id_; }
-    
+
     // Set cleanup callback to notify server when connection closes
     void setCleanupCallback(std::function<void(ConnectionId)> callback) {
         server_cleanup_callback_ = std::move(callback);
@@ -121,10 +132,17 @@ public:
 private:
     void readHeader();
     void readBody(size_t expected_length);
+    bool decodeFrameLength(size_t& body_length);
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> runSession();
+#endif
     void processMessage(const std::vector<char>& data);
     void processLoginRequest(const std::vector<char>& data);
     void processOrderRequest(const std::vector<char>& data);
-    void sendResponse(const std::vector<char>& response, uint64_t start_cycles = 0);
+    void processFastOrderRequest(const std::vector<char>& data);
+    std::vector<char> acquireResponseBuffer(size_t size);
+    void releaseResponseBuffer(std::vector<char>&& buffer);
+    void sendResponse(std::vector<char> response, uint64_t start_cycles = 0);
     void handleError(const boost::system::error_code& error);
 };
 
@@ -134,6 +152,10 @@ private:
     boost::asio::io_context io_context_;
     boost::asio::ssl::context ssl_context_;
     boost::asio::ip::tcp::acceptor acceptor_;
+    // Optional plaintext listener for colocated trusted clients
+    // (engine_config::tcpTrustedPort(); 0 = disabled, acceptor left closed)
+    boost::asio::ip::tcp::acceptor trusted_acceptor_;
+    uint16_t trusted_port_{0};
     std::vector<std::thread> worker_threads_;
     std::atomic<bool> running_{false};
     StockExchange* exchange_;
@@ -149,16 +171,10 @@ private:
     // Connection ID counter
     std::atomic<ConnectionId> next_connection_id_{1};
 
-    // Batching configuration
-    static constexpr size_t MAX_BATCH_SIZE = 64;
-    static constexpr std::chrono::microseconds BATCH_TIMEOUT{100};
-    
-    // Batch processing
-    std::vector<std::vector<char>> pending_orders_;
-    std::mutex batch_mutex_;
-    std::condition_variable batch_cv_;
-    std::thread batch_processor_;
-    std::atomic<bool> batch_processor_running_{false};
+    // AUREX_TCP_COROUTINES=1 switches new connections to the coroutine
+    // session loop (see TCPConnection); requires a toolchain where asio
+    // exposes awaitable support, otherwise falls back to callbacks.
+    bool coroutine_mode_{false};
 
 public:
     TCPServer(const std::string& address, uint16_t port, 
@@ -173,8 +189,7 @@ public:
 
 private:
     void acceptConnection();
+    void acceptTrustedConnection();
     void workerThread();
-    void batchProcessorThread();
-    void processOrderBatch(const std::vector<char>& data);
     void cleanupConnections();
 };
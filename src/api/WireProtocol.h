@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "../core_engine/Stock.h"
+#include "../common/InternTable.h"
+
+// Fixed-layout 64-byte order record shared by the TCP and shared-memory
+// ingress paths (MessageType::SUBMIT_ORDER_FAST on the wire). Unlike the
+// variable-length v1 messages there are no string lengths to bounds-check,
+// no string copies, and no double->fixed price conversion: the record is
+// validated and converted with a single cast.
+//
+// Fields are native-endian by design - the fast path targets colocated
+// same-architecture clients; cross-platform clients use the v1 messages.
+// symbol_id is the interned symbol handle, which is deterministic: the
+// exchange interns its symbol universe in configuration order at startup,
+// so id N is the Nth configured symbol (1-based; 0 is invalid).
+
+// The body flags byte must carry this sentinel so a fast record can never be
+// confused with a v1 variable-length message of coincidental size.
+static constexpr uint8_t WIRE_ORDER_FLAGS = 0xA5;
+
+// Matches MessageType::SUBMIT_ORDER_FAST in TCPServer.h.
+static constexpr uint8_t WIRE_ORDER_TYPE = 7;
+
+#pragma pack(push, 1)
+// Record body as carried after the 4-byte length prefix (TCP body reads).
+struct WireOrderBody {
+    uint8_t type;             // WIRE_ORDER_TYPE
+    uint8_t side;             // 0=BUY, 1=SELL
+    uint8_t order_type;       // 0=MARKET, 1=LIMIT, 2=IOC, 3=FOK
+    uint8_t flags;            // WIRE_ORDER_FLAGS
+    uint16_t symbol_id;       // Interned symbol handle (1-based config order)
+    uint16_t reserved;
+    uint64_t client_order_id; // Numeric order identity, non-zero
+    int64_t quantity;
+    int64_t price_cents;      // Fixed-point Price, no float conversion
+    int64_t timestamp_ms;     // 0 = stamped at the edge
+    char padding[20];
+};
+
+// Full framed record including the length prefix (shared memory slots).
+struct WireOrder {
+    uint32_t message_length;  // sizeof(WireOrder)
+    WireOrderBody body;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(WireOrderBody) == 60, "WireOrderBody must be 60 bytes");
+static_assert(sizeof(WireOrder) == 64, "WireOrder must be 64 bytes");
+
+// Validates a fast record and converts it to a core Order attributed to the
+// already-authenticated user. Returns an empty string on success, otherwise
+// the rejection reason. Interned handles and the order sequence are resolved
+// here, exactly as the v1 edges do.
+inline std::string decodeWireOrder(const WireOrderBody& wire,
+                                   const std::string& user_id, Order& out) {
+    if (wire.type != WIRE_ORDER_TYPE || wire.flags != WIRE_ORDER_FLAGS) {
+        return "malformed fast order record";
+    }
+    if (wire.side > 1) {
+        return "invalid side (must be 0=BUY or 1=SELL)";
+    }
+    if (wire.order_type > 3) {
+        return "invalid order type (must be 0-3)";
+    }
+    if (wire.quantity <= 0) {
+        return "quantity must be positive";
+    }
+    if (wire.client_order_id == 0) {
+        return "client_order_id must be non-zero";
+    }
+
+    std::string symbol = InternTable::symbols().resolve(wire.symbol_id);
+    if (symbol.empty()) {
+        return "unknown symbol id";
+    }
+
+    int64_t timestamp_ms = static_cast<int64_t>(wire.timestamp_ms);
+    if (timestamp_ms == 0) {
+        timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    out = Order(std::to_string(wire.client_order_id), user_id, symbol,
+                wire.side, wire.order_type, wire.quantity,
+                static_cast<Price>(wire.price_cents), timestamp_ms);
+    out.symbol_handle = static_cast<SymbolHandle>(wire.symbol_id);
+    out.user_handle = static_cast<UserHandle>(InternTable::users().intern(user_id));
+    out.order_seq = nextOrderSequence();
+    return "";
+}
@@ -12,6 +12,7 @@
 namespace engine_config {
 namespace {
 std::atomic<bool> g_dev_mode{false};
+std::atomic<uint16_t> g_tcp_trusted_port{0};
 } // namespace
 
 void setDevMode(bool enabled) {
@@ -22,4 +23,12 @@ bool isDevMode() {
     return g_dev_mode.load(std::memory_order_relaxed);
 }
 
+void setTcpTrustedPort(uint16_t port) {
+    g_tcp_trusted_port.store(port, std::memory_order_relaxed);
+}
+
+uint16_t tcpTrustedPort() {
+    return g_tcp_trusted_port.load(std::memory_order_relaxed);
+}
+
 } // namespace engine_config
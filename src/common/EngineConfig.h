@@ -10,6 +10,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 namespace engine_config {
 
@@ -20,4 +21,12 @@ void setDevMode(bool enabled);
 // verbose logging that is helpful during local debugging sessions.
 bool isDevMode();
 
+// Sets the port for the TCP order server's plaintext trusted-network
+// listener. Colocated internal clients on that port speak the same binary
+// protocol without TLS. 0 (the default) disables the listener.
+void setTcpTrustedPort(uint16_t port);
+
+// Returns the plaintext trusted-port, or 0 if disabled.
+uint16_t tcpTrustedPort();
+
 }
@@ -9,12 +9,114 @@
 
 #include "EngineTelemetry.h"
 
+#include <algorithm>
+#include <bit>
+#include <thread>
+
 #include <sys/resource.h>
 
 #ifdef __APPLE__
 #include <mach/mach.h>
 #endif
 
+namespace engine_clock {
+
+uint64_t cyclesPerSecond() {
+    static const uint64_t freq = []() -> uint64_t {
+#if defined(__x86_64__) || defined(_M_X64) || defined(_WIN32)
+        const auto chrono_start = std::chrono::high_resolution_clock::now();
+        const uint64_t tsc_start = cycles();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const uint64_t tsc_end = cycles();
+        const auto chrono_end = std::chrono::high_resolution_clock::now();
+        const auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(chrono_end - chrono_start).count();
+        return (tsc_end - tsc_start) * 1'000'000ULL / static_cast<uint64_t>(time_us);
+#else
+        // The fallback cycles() reads high_resolution_clock, which ticks in
+        // nanoseconds on the platforms we care about
+        return 1'000'000'000ULL;
+#endif
+    }();
+    return freq;
+}
+
+} // namespace engine_clock
+
+int EngineTelemetry::LatencyHistogram::bucketIndex(uint64_t us) {
+    if (us < SUB_BUCKETS) {
+        return static_cast<int>(us);
+    }
+    const int octave = std::bit_width(us) - SUB_BUCKET_BITS;
+    const int sub = static_cast<int>(us >> (octave - 1)) & (SUB_BUCKETS - 1);
+    const int index = octave * SUB_BUCKETS + sub;
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+uint64_t EngineTelemetry::LatencyHistogram::bucketValue(int index) {
+    const int octave = index / SUB_BUCKETS;
+    const int sub = index % SUB_BUCKETS;
+    if (octave == 0) {
+        return static_cast<uint64_t>(sub);
+    }
+    return static_cast<uint64_t>(SUB_BUCKETS + sub) << (octave - 1);
+}
+
+size_t EngineTelemetry::LatencyHistogram::threadShard() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+    return shard;
+}
+
+void EngineTelemetry::LatencyHistogram::record(uint64_t us) {
+    Shard& shard = shards_[threadShard()];
+    shard.counts[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t prev_max = shard.max_us.load(std::memory_order_relaxed);
+    while (us > prev_max &&
+           !shard.max_us.compare_exchange_weak(prev_max, us, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyStats EngineTelemetry::LatencyHistogram::stats() const {
+    uint64_t merged[BUCKET_COUNT] = {};
+    uint64_t total = 0;
+    uint64_t max_us = 0;
+    for (const Shard& shard : shards_) {
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            const uint64_t count = shard.counts[i].load(std::memory_order_relaxed);
+            merged[i] += count;
+            total += count;
+        }
+        max_us = std::max(max_us, shard.max_us.load(std::memory_order_relaxed));
+    }
+
+    LatencyStats stats;
+    stats.samples = total;
+    if (total == 0) {
+        return stats;
+    }
+    stats.maxUs = static_cast<double>(max_us);
+
+    const double quantiles[3] = {0.50, 0.99, 0.999};
+    double* outputs[3] = {&stats.p50Us, &stats.p99Us, &stats.p999Us};
+    for (int q = 0; q < 3; ++q) {
+        uint64_t rank = static_cast<uint64_t>(static_cast<double>(total) * quantiles[q]);
+        if (rank >= total) {
+            rank = total - 1;
+        }
+        uint64_t cumulative = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            cumulative += merged[i];
+            if (cumulative > rank) {
+                *outputs[q] = static_cast<double>(bucketValue(i));
+                break;
+            }
+        }
+    }
+    return stats;
+}
+
 EngineTelemetry& EngineTelemetry::instance() {
     static EngineTelemetry telemetry;
     return telemetry;
@@ -26,7 +128,11 @@ EngineTelemetry::EngineTelemetry()
       latency_samples_(0),
       last_user_us_(0),
       last_system_us_(0),
-      last_order_count_(0) {}
+      last_order_count_(0) {
+    // Pay the one-off TSC calibration here instead of on the first sampled
+    // order in the hot path
+    engine_clock::cyclesPerSecond();
+}
 
 void EngineTelemetry::recordOrder(long long latencyUs) {
     order_count_.fetch_add(1, std::memory_order_relaxed);
@@ -34,6 +140,19 @@ void EngineTelemetry::recordOrder(long long latencyUs) {
     if (latencyUs >= 0) {
         latency_sum_us_.fetch_add(latencyUs, std::memory_order_relaxed);
         latency_samples_.fetch_add(1, std::memory_order_relaxed);
+        engine_histogram_.record(static_cast<uint64_t>(latencyUs));
+    }
+}
+
+void EngineTelemetry::recordQueueWait(long long latencyUs) {
+    if (latencyUs >= 0) {
+        queue_wait_histogram_.record(static_cast<uint64_t>(latencyUs));
+    }
+}
+
+void EngineTelemetry::recordMatchTime(long long latencyUs) {
+    if (latencyUs >= 0) {
+        match_histogram_.record(static_cast<uint64_t>(latencyUs));
     }
 }
 
@@ -84,6 +203,10 @@ TelemetrySnapshot EngineTelemetry::snapshot() {
 
     snapshot.memoryMb = queryMemoryMb();
 
+    snapshot.engineLatency = engine_histogram_.stats();
+    snapshot.queueWaitLatency = queue_wait_histogram_.stats();
+    snapshot.matchLatency = match_histogram_.stats();
+
     return snapshot;
 }
 
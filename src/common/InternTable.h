@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include <absl/container/flat_hash_map.h>
+
+// Fixed-width handles for interned identifiers. Handle 0 is reserved for
+// "unresolved" so a default-constructed Order is never mistaken for a real
+// participant or symbol.
+using SymbolHandle = uint16_t;
+using UserHandle = uint32_t;
+
+constexpr SymbolHandle INVALID_SYMBOL_HANDLE = 0;
+constexpr UserHandle INVALID_USER_HANDLE = 0;
+
+// Thread-safe string interning table. Identifiers are resolved once at the
+// API edge (TCP/shared-memory ingress) into small integer handles so the
+// matching hot path compares integers instead of heap-allocated strings.
+// Interning is lock-shared on the fast path (lookup of an already-known
+// string) and takes the exclusive lock only for first-seen identifiers,
+// which for symbols happens once at startup and for users once per session.
+class InternTable {
+public:
+    InternTable() {
+        // Slot 0 is the invalid handle
+        by_handle_.push_back("");
+    }
+
+    // Returns the handle for `value`, interning it on first sight.
+    uint32_t intern(const std::string& value) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = by_string_.find(value);
+            if (it != by_string_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto [it, inserted] = by_string_.try_emplace(
+            value, static_cast<uint32_t>(by_handle_.size()));
+        if (inserted) {
+            by_handle_.push_back(value);
+        }
+        return it->second;
+    }
+
+    // Returns the handle for `value` or 0 if it was never interned.
+    uint32_t find(const std::string& value) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = by_string_.find(value);
+        return (it != by_string_.end()) ? it->second : 0;
+    }
+
+    // Resolves a handle back to its string (empty string for handle 0 or
+    // out-of-range handles). Returns by value because the backing vector can
+    // reallocate under concurrent interning.
+    std::string resolve(uint32_t handle) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (handle >= by_handle_.size()) {
+            return "";
+        }
+        return by_handle_[handle];
+    }
+
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return by_handle_.size() - 1; // Exclude the invalid slot
+    }
+
+    // Process-wide tables. Symbols fit comfortably in a uint16_t handle;
+    // callers narrow the returned uint32_t at the edge.
+    static InternTable& symbols() {
+        static InternTable table;
+        return table;
+    }
+
+    static InternTable& users() {
+        static InternTable table;
+        return table;
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    absl::flat_hash_map<std::string, uint32_t> by_string_;
+    std::vector<std::string> by_handle_;
+};
+
+// Monotonic numeric order sequence. Seeded from the wall clock (milliseconds
+// since epoch, shifted) so sequences from different engine runs do not
+// collide in downstream logs.
+inline uint64_t nextOrderSequence() {
+    static std::atomic<uint64_t> counter{
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()) << 20};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
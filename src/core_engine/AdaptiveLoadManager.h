@@ -10,18 +10,33 @@
 #pragma once
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 #include <algorithm>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
 /**
  * Adaptive Load Manager - Dynamically adjusts CPU usage based on order flow
- * 
+ *
  * Strategy:
  * - IDLE mode: Long sleeps (1-10ms) when no orders
  * - WARMING mode: Progressively shorter sleeps as orders increase
  * - ACTIVE mode: Minimal sleep (yield only) during moderate load
  * - PEAK mode: Full busy-wait (no sleep) during high-frequency trading
- * 
+ *
+ * The IDLE/LOW rungs are event-driven rather than pure sleeps: the consumer
+ * parks on a futex and producers call notifyWork() after enqueueing, so the
+ * first order after a quiet spell is picked up immediately instead of
+ * waiting out the remainder of a 5ms sleep. PEAK stays a pure busy-wait and
+ * the producer-side cost while the consumer is polling is a single relaxed
+ * load. On non-Linux builds the parked wait degrades to the plain sleep.
+ *
  * Benefits:
  * - Near-zero CPU usage when idle
  * - Sub-millisecond latency during active trading
@@ -54,6 +69,12 @@ private:
     std::atomic<LoadLevel> current_level_{LoadLevel::IDLE};
     std::atomic<int> iteration_count_{0};
     std::atomic<int> work_count_{0};
+
+    // Parked-consumer wakeup state. wake_seq_ counts producer publishes and
+    // doubles as the futex word; consumer_parked_ lets producers skip the
+    // wake syscall entirely while the consumer is still polling.
+    std::atomic<uint32_t> wake_seq_{0};
+    std::atomic<bool> consumer_parked_{false};
     
     // Hysteresis to prevent rapid mode switching
     int level_switch_delay_{0};
@@ -80,17 +101,49 @@ public:
     }
     
     /**
-     * Sleep/yield based on current load level
+     * Producer-side wake hook: call after publishing work to the consumer's
+     * queue. While the consumer is polling (WARMING and above) this is one
+     * relaxed load; only when the consumer may be parked in IDLE/LOW does it
+     * bump the wake sequence and pay a futex wake.
      */
-    void waitForWork() {
+    void notifyWork() {
         LoadLevel level = current_level_.load(std::memory_order_relaxed);
-        
+        if (level != LoadLevel::IDLE && level != LoadLevel::LOW) {
+            return;  // Consumer already polls at sub-millisecond cadence
+        }
+        wake_seq_.fetch_add(1, std::memory_order_release);
+        if (consumer_parked_.exchange(false, std::memory_order_seq_cst)) {
+#if defined(__linux__)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_seq_),
+                    FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#endif
+        }
+    }
+
+    /**
+     * Capture the wake sequence BEFORE the final empty poll of the queue,
+     * then hand the token to waitForWork(). A publish landing between the
+     * capture and the park changes the sequence, so the futex wait returns
+     * immediately instead of sleeping on work that is already queued.
+     */
+    uint32_t prepareWait() {
+        return wake_seq_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Sleep/yield based on current load level. IDLE/LOW park on the futex
+     * (bounded by the old sleep duration so shutdown polling still works);
+     * the faster rungs keep their short sleeps and PEAK stays a busy-wait.
+     */
+    void waitForWork(uint32_t wake_token) {
+        LoadLevel level = current_level_.load(std::memory_order_relaxed);
+
         switch (level) {
             case LoadLevel::IDLE:
-                std::this_thread::sleep_for(SLEEP_IDLE);
+                parkedWait(wake_token, SLEEP_IDLE);
                 break;
             case LoadLevel::LOW:
-                std::this_thread::sleep_for(SLEEP_LOW);
+                parkedWait(wake_token, SLEEP_LOW);
                 break;
             case LoadLevel::WARMING:
                 std::this_thread::sleep_for(SLEEP_WARMING);
@@ -143,10 +196,32 @@ public:
         iteration_count_.store(0, std::memory_order_relaxed);
         work_count_.store(0, std::memory_order_relaxed);
         current_level_.store(LoadLevel::IDLE, std::memory_order_relaxed);
+        consumer_parked_.store(false, std::memory_order_relaxed);
         level_switch_delay_ = 0;
     }
 
 private:
+    void parkedWait(uint32_t wake_token, std::chrono::nanoseconds max_wait) {
+        consumer_parked_.store(true, std::memory_order_seq_cst);
+        if (wake_seq_.load(std::memory_order_seq_cst) != wake_token) {
+            // Work was published while we were preparing to park
+            consumer_parked_.store(false, std::memory_order_relaxed);
+            return;
+        }
+#if defined(__linux__)
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(max_wait.count() / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(max_wait.count() % 1000000000LL);
+        // Returns immediately (EAGAIN) if a producer bumped the sequence
+        // after our check; otherwise sleeps until woken or the timeout
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_seq_),
+                FUTEX_WAIT, wake_token, &ts, nullptr, 0);
+#else
+        std::this_thread::sleep_for(max_wait);
+#endif
+        consumer_parked_.store(false, std::memory_order_relaxed);
+    }
+
     void updateLoadLevel() {
         int work = work_count_.exchange(0, std::memory_order_relaxed);
         iteration_count_.store(0, std::memory_order_relaxed);
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// One resting order as captured in a binary book snapshot file. Fixed-size
+// and trivially copyable so a whole book is one header plus a flat array
+// write, and restore is a single sequential read.
+struct SnapshotOrderRecord {
+  char order_id[50];
+  char user_id[50];
+  char symbol[16];
+  int32_t side;
+  int32_t type;
+  int64_t quantity;
+  int64_t remaining_qty;
+  int64_t price; // Fixed-point cents, same convention as Price
+  int64_t timestamp_ms;
+  uint64_t order_seq;
+};
+
+static_assert(std::is_trivially_copyable<SnapshotOrderRecord>::value,
+              "Snapshot records must be trivially copyable");
+
+// Reader/writer for per-symbol book snapshot files. The writer streams to
+// <path>.tmp, fsyncs, then renames over the previous snapshot, so a crash
+// mid-write leaves the last complete snapshot intact and restore never sees
+// a torn file. POSIX-only, like Journal.h; on Windows both operations no-op
+// and the engine starts with empty books as before.
+class BookSnapshot {
+private:
+  struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+    int64_t taken_at_ms;
+  };
+
+  static constexpr uint64_t MAGIC = 0x4155524558534E31ull; // "AUREXSN1"
+  static constexpr uint32_t VERSION = 1;
+
+#ifndef _WIN32
+  static bool writeAll(int fd, const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+      ssize_t written = ::write(fd, bytes, size);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      bytes += written;
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  static bool readAll(int fd, void *data, size_t size) {
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    while (size > 0) {
+      ssize_t bytes_read = ::read(fd, bytes, size);
+      if (bytes_read < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      if (bytes_read == 0) {
+        return false; // Truncated file
+      }
+      bytes += bytes_read;
+      size -= static_cast<size_t>(bytes_read);
+    }
+    return true;
+  }
+
+public:
+  static bool write(const std::string &path, int64_t taken_at_ms,
+                    const std::vector<SnapshotOrderRecord> &records) {
+    const std::string tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      std::cerr << "BookSnapshot: failed to open " << tmp_path << std::endl;
+      return false;
+    }
+
+    Header header{MAGIC, VERSION, sizeof(SnapshotOrderRecord), records.size(),
+                  taken_at_ms};
+    bool ok = writeAll(fd, &header, sizeof(header));
+    if (ok && !records.empty()) {
+      ok = writeAll(fd, records.data(),
+                    records.size() * sizeof(SnapshotOrderRecord));
+    }
+    if (ok) {
+      ok = (fsync(fd) == 0);
+    }
+    ::close(fd);
+
+    // Atomic swap: restore either sees the previous snapshot or this one
+    if (ok) {
+      ok = (std::rename(tmp_path.c_str(), path.c_str()) == 0);
+    }
+    if (!ok) {
+      std::remove(tmp_path.c_str());
+      std::cerr << "BookSnapshot: failed to write " << path << std::endl;
+    }
+    return ok;
+  }
+
+  static bool read(const std::string &path, int64_t &taken_at_ms,
+                   std::vector<SnapshotOrderRecord> &out) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false; // Absent on first boot; not an error
+    }
+
+    Header header;
+    if (!readAll(fd, &header, sizeof(header)) || header.magic != MAGIC) {
+      ::close(fd);
+      return false;
+    }
+    if (header.record_size != sizeof(SnapshotOrderRecord)) {
+      // Layout changed between builds: refuse rather than misread records
+      std::cerr << "BookSnapshot: " << path
+                << " has incompatible layout, ignoring" << std::endl;
+      ::close(fd);
+      return false;
+    }
+
+    out.resize(header.count);
+    bool ok = header.count == 0 ||
+              readAll(fd, out.data(),
+                      header.count * sizeof(SnapshotOrderRecord));
+    ::close(fd);
+    if (!ok) {
+      out.clear();
+      std::cerr << "BookSnapshot: " << path << " is truncated, ignoring"
+                << std::endl;
+      return false;
+    }
+    taken_at_ms = header.taken_at_ms;
+    return true;
+  }
+#else
+  // Snapshots are POSIX-only; the engine starts with empty books on Windows
+  static bool write(const std::string &, int64_t,
+                    const std::vector<SnapshotOrderRecord> &) {
+    return false;
+  }
+  static bool read(const std::string &, int64_t &,
+                   std::vector<SnapshotOrderRecord> &) {
+    return false;
+  }
+#endif
+};
@@ -8,6 +8,11 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -70,15 +75,81 @@ public:
     static std::vector<int> getAvailableCores() {
         std::vector<int> cores;
         int total_cores = getCoreCount();
-        
+
         // Reserve first core for system/OS, use remaining cores
         for (int i = 1; i < total_cores; ++i) {
             cores.push_back(i);
         }
-        
+
         return cores;
     }
-    
+
+    // Per-core topology discovered from sysfs (Linux). On other platforms,
+    // or when sysfs is unreadable, every core reports node 0 / its own L3 /
+    // SMT-primary / not isolated, which degrades placement to the old
+    // sequential order.
+    struct CoreTopology {
+        int core{0};
+        int numa_node{0};      // Physical package id - the socket boundary
+                               // cross-socket queue traffic must not cross
+        int l3_group{0};       // First cpu of the shared-L3 set
+        bool smt_primary{true};// First listed sibling of its physical core
+        bool isolated{false};  // In the kernel's isolcpus set
+    };
+
+    static std::vector<CoreTopology> getTopology() {
+        std::vector<CoreTopology> topology;
+#if !defined(_WIN32) && !defined(__APPLE__)
+        const std::vector<int> isolated = parseCpuList(
+            readFirstLine("/sys/devices/system/cpu/isolated"));
+#endif
+        for (int core : getAvailableCores()) {
+            CoreTopology info;
+            info.core = core;
+            info.l3_group = core;
+#if !defined(_WIN32) && !defined(__APPLE__)
+            const std::string base =
+                "/sys/devices/system/cpu/cpu" + std::to_string(core) + "/";
+            info.numa_node = readFirstInt(base + "topology/physical_package_id", 0);
+            auto l3_cpus = parseCpuList(readFirstLine(base + "cache/index3/shared_cpu_list"));
+            if (!l3_cpus.empty()) {
+                info.l3_group = l3_cpus.front();
+            }
+            auto siblings = parseCpuList(readFirstLine(base + "topology/thread_siblings_list"));
+            if (!siblings.empty()) {
+                info.smt_primary = (siblings.front() == core);
+            }
+            info.isolated = std::find(isolated.begin(), isolated.end(), core) != isolated.end();
+#endif
+            topology.push_back(info);
+        }
+        return topology;
+    }
+
+    // Available cores reordered so that consecutive entries share a socket
+    // and an L3: grouped by NUMA node, then L3 group, with isolated cores
+    // first (the busy-wait matching threads land there) and one SMT sibling
+    // per physical core before any second siblings. Callers that hand out
+    // consecutive cores to a symbol's producer/consumer threads therefore
+    // keep each symbol's SPSC traffic inside one cache domain.
+    static std::vector<int> getPlacementCores() {
+        auto topology = getTopology();
+        std::stable_sort(topology.begin(), topology.end(),
+                         [](const CoreTopology& a, const CoreTopology& b) {
+                             if (a.numa_node != b.numa_node) return a.numa_node < b.numa_node;
+                             if (a.l3_group != b.l3_group) return a.l3_group < b.l3_group;
+                             if (a.isolated != b.isolated) return a.isolated;
+                             if (a.smt_primary != b.smt_primary) return a.smt_primary;
+                             return a.core < b.core;
+                         });
+        std::vector<int> cores;
+        cores.reserve(topology.size());
+        for (const auto& info : topology) {
+            cores.push_back(info.core);
+        }
+        return cores;
+    }
+
     // Set thread priority (high priority for matching engine)
     static bool setHighPriority(std::thread& thread) {
 #ifdef _WIN32
@@ -106,4 +177,41 @@ public:
         return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
 #endif
     }
+
+private:
+    static std::string readFirstLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        if (file.is_open()) {
+            std::getline(file, line);
+        }
+        return line;
+    }
+
+    static int readFirstInt(const std::string& path, int fallback) {
+        const std::string line = readFirstLine(path);
+        return line.empty() ? fallback : std::atoi(line.c_str());
+    }
+
+    // Parses the sysfs cpulist format, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string token;
+        while (std::getline(stream, token, ',')) {
+            const size_t dash = token.find('-');
+            if (dash == std::string::npos) {
+                if (!token.empty()) {
+                    cpus.push_back(std::atoi(token.c_str()));
+                }
+            } else {
+                const int first = std::atoi(token.substr(0, dash).c_str());
+                const int last = std::atoi(token.substr(dash + 1).c_str());
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+        return cpus;
+    }
 };
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Process-wide structure-of-arrays block of per-symbol daily stats, indexed
+// by interned symbol handle (1-based configuration order, see InternTable).
+//
+// Each Stock binds references into its slot, so the matching path updates the
+// same relaxed atomics it always did - but across all symbols each field is
+// one contiguous array, and the all-stocks snapshot builder sweeps five
+// arrays with linear loads instead of calling ~10 getters per Stock and
+// bouncing between every book's cache lines.
+//
+// Values are fixed-point cents (prices) and shares (volume). Slot 0 is the
+// invalid-handle spillover and is never used by the configured universe.
+class DailyStatsBoard {
+public:
+    // Comfortably above any symbol universe we configure; handles past this
+    // (stray interns of unknown symbols at the API edge) share slot 0
+    static constexpr size_t CAPACITY = 4096;
+
+    static DailyStatsBoard& instance() {
+        static DailyStatsBoard board;
+        return board;
+    }
+
+    static size_t slotFor(uint32_t symbol_handle) {
+        return symbol_handle < CAPACITY ? symbol_handle : 0;
+    }
+
+    std::atomic<int64_t>& last(size_t slot) { return last_[slot]; }
+    std::atomic<int64_t>& open(size_t slot) { return open_[slot]; }
+    std::atomic<int64_t>& high(size_t slot) { return high_[slot]; }
+    std::atomic<int64_t>& low(size_t slot) { return low_[slot]; }
+    std::atomic<int64_t>& volume(size_t slot) { return volume_[slot]; }
+
+private:
+    DailyStatsBoard() = default;
+    DailyStatsBoard(const DailyStatsBoard&) = delete;
+    DailyStatsBoard& operator=(const DailyStatsBoard&) = delete;
+
+    std::array<std::atomic<int64_t>, CAPACITY> last_{};
+    std::array<std::atomic<int64_t>, CAPACITY> open_{};
+    std::array<std::atomic<int64_t>, CAPACITY> high_{};
+    std::array<std::atomic<int64_t>, CAPACITY> low_{};
+    std::array<std::atomic<int64_t>, CAPACITY> volume_{};
+};
@@ -9,7 +9,9 @@
 
 #include "DatabaseManager.h"
 #include "../common/EngineLogging.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -28,9 +30,11 @@ DatabaseManager::~DatabaseManager() {
 
 bool DatabaseManager::connect() {
   try {
-    // Initialize connection pool
-    connection_pool_ =
-        std::make_unique<ConnectionPool>(connection_string_, pool_size_);
+    // Initialize connection pool; every connection registers the persistence
+    // prepared statements before entering rotation
+    connection_pool_ = std::make_unique<ConnectionPool>(
+        connection_string_, pool_size_,
+        [](pqxx::connection &conn) { prepareStatements(conn); });
     if (!connection_pool_->initialize()) {
       std::cerr << "Failed to initialize connection pool" << std::endl;
       // CRITICAL FIX: Reset connection_pool_ to nullptr on failure
@@ -43,6 +47,32 @@ bool DatabaseManager::connect() {
                        << "Connected to PostgreSQL database with pool size: "
                        << pool_size_ << std::endl;);
     initializeTables();
+
+    // Rows per COPY transaction in the persistence worker; larger batches
+    // amortize the commit, smaller ones bound replay-after-crash work
+    if (const char *batch_env = std::getenv("AUREX_PERSIST_BATCH_SIZE")) {
+      int parsed = std::atoi(batch_env);
+      if (parsed > 0) {
+        persist_batch_size_ =
+            std::min(static_cast<size_t>(parsed), static_cast<size_t>(16384));
+      }
+    }
+
+    // Open the write-ahead journal and replay anything a previous run
+    // journaled but never confirmed into the database
+    std::string journal_dir = ".";
+    if (const char *dir = std::getenv("AUREX_JOURNAL_DIR")) {
+      journal_dir = dir;
+    }
+    if (journal_.open(journal_dir + "/aurex_persistence.wal",
+                      JOURNAL_CAPACITY)) {
+      replayJournal();
+    } else {
+      std::cerr << "Warning: persistence journal unavailable, queue-full "
+                   "events will be dropped"
+                << std::endl;
+    }
+
     return true;
   } catch (const std::exception &e) {
     std::cerr << "Database connection error: " << e.what() << std::endl;
@@ -52,6 +82,41 @@ bool DatabaseManager::connect() {
   }
 }
 
+void DatabaseManager::prepareStatements(pqxx::connection &conn) {
+  // Server-side prepared statements for the per-row persistence paths: the
+  // server parses and plans each once per connection instead of once per row
+  conn.prepare("persist_order", R"(
+        INSERT INTO orders (order_id, user_id, symbol, side, order_type, quantity, price, status, timestamp_ms)
+        VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
+        ON CONFLICT (order_id) DO UPDATE
+        SET user_id = EXCLUDED.user_id,
+            symbol = EXCLUDED.symbol,
+            side = EXCLUDED.side,
+            order_type = EXCLUDED.order_type,
+            quantity = EXCLUDED.quantity,
+            price = EXCLUDED.price,
+            status = EXCLUDED.status,
+            timestamp_ms = EXCLUDED.timestamp_ms,
+            updated_at = CURRENT_TIMESTAMP
+    )");
+
+  conn.prepare("persist_trade", R"(
+        INSERT INTO trades (trade_id, buy_order_id, sell_order_id, symbol, price, quantity,
+                           buyer_id, seller_id, timestamp_ms)
+        VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
+        ON CONFLICT (trade_id) DO NOTHING
+    )");
+
+  conn.prepare("stock_upsert", R"(
+        INSERT INTO stocks (symbol, last_price, open_price, volume, timestamp_ms)
+        VALUES ($1, $2, $3, $4, $5)
+        ON CONFLICT (symbol, timestamp_ms) DO UPDATE SET
+            last_price = EXCLUDED.last_price,
+            open_price = EXCLUDED.open_price,
+            volume = EXCLUDED.volume
+    )");
+}
+
 void DatabaseManager::disconnect() {
   connection_pool_.reset();
   ENGINE_LOG_DEV(std::cout << "Database connection pool closed" << std::endl;);
@@ -295,16 +360,9 @@ bool DatabaseManager::saveStockData(const StockData &data) {
     ScopedConnection conn(*connection_pool_);
     pqxx::work txn(conn.get());
 
-    txn.exec_params(R"(
-            INSERT INTO stocks (symbol, last_price, open_price, volume, timestamp_ms)
-            VALUES ($1, $2, $3, $4, $5)
-            ON CONFLICT (symbol, timestamp_ms) DO UPDATE SET
-                last_price = EXCLUDED.last_price,
-                open_price = EXCLUDED.open_price,
-                volume = EXCLUDED.volume
-        )",
-                    data.symbol, data.lastPriceToDouble(),
-                    data.openPriceToDouble(), data.volume, data.timestamp_ms);
+    txn.exec_prepared("stock_upsert", data.symbol, data.lastPriceToDouble(),
+                      data.openPriceToDouble(), data.volume,
+                      data.timestamp_ms);
 
     txn.commit();
     return true;
@@ -316,32 +374,75 @@ bool DatabaseManager::saveStockData(const StockData &data) {
 
 bool DatabaseManager::saveStockDataBatch(
     const std::vector<StockData> &data_batch) {
+  if (data_batch.empty())
+    return true;
+  if (!connection_pool_)
+    return false;
+
+  ScopedConnection conn(*connection_pool_);
+
+  // COPY the batch into a temp staging table and upsert in one statement
+  // instead of one round trip per row
   try {
-    ScopedConnection conn(*connection_pool_);
     pqxx::work txn(conn.get());
 
-    for (const auto &data : data_batch) {
-      txn.exec_params(R"(
-                INSERT INTO stocks (symbol, last_price, open_price, volume, timestamp_ms)
-                VALUES ($1, $2, $3, $4, $5)
-                ON CONFLICT (symbol, timestamp_ms) DO UPDATE SET
-                    last_price = EXCLUDED.last_price,
-                    open_price = EXCLUDED.open_price,
-                    volume = EXCLUDED.volume
-            )",
-                      data.symbol, data.lastPriceToDouble(),
-                      data.openPriceToDouble(), data.volume, data.timestamp_ms);
+    txn.exec(R"(
+            CREATE TEMP TABLE stocks_staging (
+                symbol VARCHAR(10),
+                last_price DECIMAL(15,4),
+                open_price DECIMAL(15,4),
+                volume BIGINT,
+                timestamp_ms BIGINT
+            ) ON COMMIT DROP
+        )");
+
+    {
+      pqxx::stream_to stock_stream(txn, "stocks_staging");
+      for (const auto &data : data_batch) {
+        stock_stream << std::make_tuple(data.symbol, data.lastPriceToDouble(),
+                                        data.openPriceToDouble(), data.volume,
+                                        data.timestamp_ms);
+      }
+      stock_stream.complete();
     }
 
+    txn.exec(R"(
+            INSERT INTO stocks (symbol, last_price, open_price, volume, timestamp_ms)
+            SELECT symbol, last_price, open_price, volume, timestamp_ms
+            FROM stocks_staging
+            ON CONFLICT (symbol, timestamp_ms) DO UPDATE SET
+                last_price = EXCLUDED.last_price,
+                open_price = EXCLUDED.open_price,
+                volume = EXCLUDED.volume
+        )");
+
     txn.commit();
     ENGINE_LOG_DEV(std::cout << "Saved " << data_batch.size()
                              << " stock data records to database"
                              << std::endl;);
     return true;
   } catch (const std::exception &e) {
-    std::cerr << "Error saving stock data batch: " << e.what() << std::endl;
-    return false;
+    std::cerr << "Error saving stock data batch via COPY: " << e.what()
+              << " - falling back to per-row writes" << std::endl;
   }
+
+  // Per-row fallback: one prepared-statement transaction per record so a
+  // single bad row cannot sink the whole batch
+  size_t failures = 0;
+  for (const auto &data : data_batch) {
+    try {
+      pqxx::work txn(conn.get());
+      txn.exec_prepared("stock_upsert", data.symbol, data.lastPriceToDouble(),
+                        data.openPriceToDouble(), data.volume,
+                        data.timestamp_ms);
+      txn.commit();
+    } catch (const std::exception &e) {
+      std::cerr << "Error saving stock data row for " << data.symbol << ": "
+                << e.what() << std::endl;
+      ++failures;
+    }
+  }
+  return failures == 0;
 }
 
 std::vector<StockData> DatabaseManager::loadStockData() {
@@ -457,14 +558,23 @@ bool DatabaseManager::persistOrder(const std::string &order_id,
   entry->status[sizeof(entry->status) - 1] = '\0'; // Ensure null termination
   entry->timestamp_ms = timestamp_ms;
 
+  // Journal first: once the record is in the WAL it survives queue-full
+  // drops and crashes before the async DB write
+  bool journaled = journal_.append(*entry);
+
   // Enqueue for background processing
   if (!persistence_queue_.enqueue(entry)) {
-    // Fallback NO LONGER BLOCKS
-    // If queue is full, we must drop the event rather than blocking the
-    // matching engine In a real production system, this would go to a separate
-    // high-speed "spillover" log file or ring buffer on another thread.
-    std::cerr << "[CRITICAL] Persistence queue full - DROPPING order "
-              << order_id << " to prevent engine stall" << std::endl;
+    // Fallback NO LONGER BLOCKS: if the queue is full we drop the event from
+    // the in-memory path rather than stall the matching engine. The journal
+    // copy (if any) is replayed into the database on the next startup.
+    if (journaled) {
+      journal_.commit();
+      std::cerr << "[WARN] Persistence queue full - order " << order_id
+                << " spilled to journal for replay" << std::endl;
+    } else {
+      std::cerr << "[CRITICAL] Persistence queue full - DROPPING order "
+                << order_id << " to prevent engine stall" << std::endl;
+    }
 
     // We still return true to the caller so they don't think the order failed
     // validation. The order is in memory and processed, just not persisted to
@@ -512,10 +622,26 @@ bool DatabaseManager::persistTrade(const std::string &buy_order_id,
       '\0'; // Ensure null termination
   entry->timestamp_ms = timestamp_ms;
 
+  // Generate the trade id here, before journaling, so the worker, the
+  // per-row fallback, and journal replay all insert the same id and the
+  // ON CONFLICT (trade_id) dedup holds across restarts
+  const std::string trade_id = nextTradeId(*entry);
+  std::strncpy(entry->trade_id, trade_id.c_str(), sizeof(entry->trade_id) - 1);
+  entry->trade_id[sizeof(entry->trade_id) - 1] = '\0';
+
+  // Journal first (see persistOrder)
+  bool journaled = journal_.append(*entry);
+
   if (!persistence_queue_.enqueue(entry)) {
     // Fallback NO LONGER BLOCKS
-    std::cerr << "[CRITICAL] Persistence queue full - DROPPING trade " << symbol
-              << " to prevent engine stall" << std::endl;
+    if (journaled) {
+      journal_.commit();
+      std::cerr << "[WARN] Persistence queue full - trade " << symbol
+                << " spilled to journal for replay" << std::endl;
+    } else {
+      std::cerr << "[CRITICAL] Persistence queue full - DROPPING trade "
+                << symbol << " to prevent engine stall" << std::endl;
+    }
 
     persistence_pool_.deallocate(entry);
   }
@@ -523,89 +649,198 @@ bool DatabaseManager::persistTrade(const std::string &buy_order_id,
   return true;
 }
 
+// Trade rows carry no ID from the matching path, so persistTrade derives one
+// when the entry is built: timestamp + hash of both order IDs + a
+// process-local sequence. The id is stored in the entry (and thus the
+// journal) so every downstream insert path reuses it; the sequence restarting
+// at zero each run therefore cannot produce a second id for the same trade.
+std::string DatabaseManager::nextTradeId(const PersistenceEntry &entry) {
+  const uint64_t sequence =
+      trade_id_sequence_.fetch_add(1, std::memory_order_relaxed);
+  // Use simple hash of ID strings for consistency
+  size_t h1 = 0, h2 = 0;
+  for (const char *p = entry.buy_order_id; *p; ++p)
+    h1 = h1 * 31 + *p;
+  for (const char *p = entry.sell_order_id; *p; ++p)
+    h2 = h2 * 31 + *p;
+
+  std::ostringstream id_builder;
+  id_builder << "TRD_" << entry.timestamp_ms << "_" << std::hex
+             << std::uppercase << (h1 ^ h2) << "_" << sequence;
+  return id_builder.str();
+}
+
+// COPY a batch into temp staging tables, then upsert so re-delivered records
+// (journal replay, retried batches) are harmless duplicates. Caller owns the
+// transaction and the commit.
+void DatabaseManager::copyEntries(
+    pqxx::work &txn, const std::vector<const PersistenceEntry *> &entries) {
+  txn.exec(R"(
+        CREATE TEMP TABLE journal_orders (
+            order_id VARCHAR(50),
+            user_id VARCHAR(50),
+            symbol VARCHAR(10),
+            side INTEGER,
+            order_type INTEGER,
+            quantity BIGINT,
+            price DECIMAL(15,4),
+            status VARCHAR(20),
+            timestamp_ms BIGINT
+        ) ON COMMIT DROP
+    )");
+  txn.exec(R"(
+        CREATE TEMP TABLE journal_trades (
+            trade_id VARCHAR(100),
+            buy_order_id VARCHAR(50),
+            sell_order_id VARCHAR(50),
+            symbol VARCHAR(10),
+            price DECIMAL(15,4),
+            quantity BIGINT,
+            buyer_id VARCHAR(50),
+            seller_id VARCHAR(50),
+            timestamp_ms BIGINT
+        ) ON COMMIT DROP
+    )");
+
+  // Only one COPY may be active per connection, so stream orders first,
+  // then trades
+  {
+    pqxx::stream_to order_stream(txn, "journal_orders");
+    for (const auto *entry : entries) {
+      if (entry->type != PersistenceType::ORDER) {
+        continue;
+      }
+      double price_dollars = static_cast<double>(entry->price) / 100.0;
+      order_stream << std::make_tuple(
+          std::string(entry->order_id), std::string(entry->user_id),
+          std::string(entry->symbol), entry->side, entry->order_type,
+          entry->quantity, price_dollars, std::string(entry->status),
+          entry->timestamp_ms);
+    }
+    order_stream.complete();
+  }
+  {
+    pqxx::stream_to trade_stream(txn, "journal_trades");
+    for (const auto *entry : entries) {
+      if (entry->type != PersistenceType::TRADE) {
+        continue;
+      }
+      double price_dollars = static_cast<double>(entry->price) / 100.0;
+      trade_stream << std::make_tuple(
+          std::string(entry->trade_id), std::string(entry->buy_order_id),
+          std::string(entry->sell_order_id), std::string(entry->symbol),
+          price_dollars, entry->quantity, std::string(entry->buyer_id),
+          std::string(entry->seller_id), entry->timestamp_ms);
+    }
+    trade_stream.complete();
+  }
+
+  txn.exec(R"(
+        INSERT INTO orders (order_id, user_id, symbol, side, order_type, quantity, price, status, timestamp_ms)
+        SELECT order_id, user_id, symbol, side, order_type, quantity, price, status, timestamp_ms
+        FROM journal_orders
+        ON CONFLICT (order_id) DO UPDATE
+        SET user_id = EXCLUDED.user_id,
+            symbol = EXCLUDED.symbol,
+            side = EXCLUDED.side,
+            order_type = EXCLUDED.order_type,
+            quantity = EXCLUDED.quantity,
+            price = EXCLUDED.price,
+            status = EXCLUDED.status,
+            timestamp_ms = EXCLUDED.timestamp_ms,
+            updated_at = CURRENT_TIMESTAMP
+    )");
+  txn.exec(R"(
+        INSERT INTO trades (trade_id, buy_order_id, sell_order_id, symbol, price, quantity,
+                           buyer_id, seller_id, timestamp_ms)
+        SELECT trade_id, buy_order_id, sell_order_id, symbol, price, quantity,
+               buyer_id, seller_id, timestamp_ms
+        FROM journal_trades
+        ON CONFLICT (trade_id) DO NOTHING
+    )");
+}
+
+bool DatabaseManager::persistEntryRow(pqxx::connection &conn,
+                                      const PersistenceEntry &entry) {
+  try {
+    pqxx::work txn(conn);
+    double price_dollars = static_cast<double>(entry.price) / 100.0;
+    if (entry.type == PersistenceType::ORDER) {
+      txn.exec_prepared("persist_order", entry.order_id, entry.user_id,
+                        entry.symbol, entry.side, entry.order_type,
+                        entry.quantity, price_dollars, entry.status,
+                        entry.timestamp_ms);
+    } else if (entry.type == PersistenceType::TRADE) {
+      txn.exec_prepared("persist_trade", entry.trade_id, entry.buy_order_id,
+                        entry.sell_order_id, entry.symbol, price_dollars,
+                        entry.quantity, entry.buyer_id, entry.seller_id,
+                        entry.timestamp_ms);
+    }
+    txn.commit();
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << "Persistence row error: " << e.what() << std::endl;
+    return false;
+  }
+}
+
 void DatabaseManager::persistenceWorker() {
-  const int BATCH_SIZE = 100;
+  std::vector<PersistenceEntry *> drain_buffer(persist_batch_size_);
   std::vector<PersistenceEntry *> batch;
-  batch.reserve(BATCH_SIZE);
+  std::vector<const PersistenceEntry *> batch_view;
+  batch.reserve(persist_batch_size_);
+  batch_view.reserve(persist_batch_size_);
 
   while (persistence_running_.load()) {
-    // Drain queue up to batch size
-    for (int i = 0; i < BATCH_SIZE; ++i) {
-      auto entry = persistence_queue_.dequeue();
-      if (entry) {
-        batch.push_back(entry);
-      } else {
-        break; // Queue empty (or skipped slot)
-      }
-    }
+    // Drain queue up to batch size with a single tail update
+    size_t drained =
+        persistence_queue_.dequeue_bulk(drain_buffer.data(), drain_buffer.size());
+    batch.assign(drain_buffer.data(), drain_buffer.data() + drained);
 
     if (batch.empty()) {
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
       continue;
     }
 
+    // WAL ordering: make the journaled copies of these entries durable with
+    // one msync before attempting the database write. If we crash or the
+    // write fails, connect() replays them from the journal.
+    journal_.commit();
+
+    batch_view.assign(batch.begin(), batch.end());
+    bool applied = false;
     try {
       ScopedConnection conn(*connection_pool_);
-      pqxx::work txn(conn.get());
-
-      for (auto *entry : batch) {
-        if (entry->type == PersistenceType::ORDER) {
-          double price_dollars = static_cast<double>(entry->price) / 100.0;
-          txn.exec_params(R"(
-                        INSERT INTO orders (order_id, user_id, symbol, side, order_type, quantity, price, status, timestamp_ms)
-                        VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
-                        ON CONFLICT (order_id) DO UPDATE 
-                        SET user_id = EXCLUDED.user_id,
-                            symbol = EXCLUDED.symbol,
-                            side = EXCLUDED.side,
-                            order_type = EXCLUDED.order_type,
-                            quantity = EXCLUDED.quantity,
-                            price = EXCLUDED.price,
-                            status = EXCLUDED.status,
-                            timestamp_ms = EXCLUDED.timestamp_ms,
-                            updated_at = CURRENT_TIMESTAMP
-                    )",
-                          entry->order_id, entry->user_id, entry->symbol,
-                          entry->side, entry->order_type, entry->quantity,
-                          price_dollars, entry->status, entry->timestamp_ms);
-        } else if (entry->type == PersistenceType::TRADE) {
-          double price_dollars = static_cast<double>(entry->price) / 100.0;
-
-          // Re-generate ID here or store it in entry?
-          // Storing in entry would be better but let's generate here for now to
-          // save space Note: Sequence might be slightly out of order but that's
-          // fine for ID uniqueness
-          const uint64_t sequence =
-              trade_id_sequence_.fetch_add(1, std::memory_order_relaxed);
-          // Use simple hash of ID strings for consistency
-          size_t h1 = 0, h2 = 0;
-          for (const char *p = entry->buy_order_id; *p; ++p)
-            h1 = h1 * 31 + *p;
-          for (const char *p = entry->sell_order_id; *p; ++p)
-            h2 = h2 * 31 + *p;
-
-          std::ostringstream id_builder;
-          id_builder << "TRD_" << entry->timestamp_ms << "_" << std::hex
-                     << std::uppercase << (h1 ^ h2) << "_" << sequence;
-          const std::string trade_id = id_builder.str();
-
-          txn.exec_params(R"(
-                        INSERT INTO trades (trade_id, buy_order_id, sell_order_id, symbol, price, quantity, 
-                                           buyer_id, seller_id, timestamp_ms)
-                        VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)
-                        ON CONFLICT (trade_id) DO NOTHING
-                    )",
-                          trade_id, entry->buy_order_id, entry->sell_order_id,
-                          entry->symbol, price_dollars, entry->quantity,
-                          entry->buyer_id, entry->seller_id,
-                          entry->timestamp_ms);
+      try {
+        // Hot path: one COPY transaction for the whole drain
+        pqxx::work txn(conn.get());
+        copyEntries(txn, batch_view);
+        txn.commit();
+        applied = true;
+      } catch (const std::exception &e) {
+        std::cerr << "Persistence worker COPY error: " << e.what()
+                  << " - retrying per row" << std::endl;
+        // Per-row fallback isolates a poison row; anything that still fails
+        // stays pending in the journal for replay on next startup
+        size_t failures = 0;
+        for (const auto *entry : batch_view) {
+          if (!persistEntryRow(conn.get(), *entry)) {
+            ++failures;
+          }
         }
+        applied = (failures == 0);
       }
-
-      txn.commit();
     } catch (const std::exception &e) {
       std::cerr << "Persistence worker error: " << e.what() << std::endl;
-      // In a real system, we might retry or DLQ these events
+      // Entries stay pending in the journal and are replayed on next startup
+    }
+
+    if (applied) {
+      // Advance the journal's applied watermark. With concurrent spill
+      // appends the watermark is approximate; replay is idempotent (upserts
+      // keyed by order_id / trade_id), so a boundary record is at worst
+      // replayed twice, not lost.
+      journal_.markApplied(batch.size());
     }
 
     // Return to pool
@@ -616,6 +851,39 @@ void DatabaseManager::persistenceWorker() {
   }
 }
 
+void DatabaseManager::replayJournal() {
+  std::vector<PersistenceEntry> pending = journal_.readPending();
+  if (pending.empty()) {
+    return;
+  }
+
+  ENGINE_LOG_DEV(std::cout << "Replaying " << pending.size()
+                           << " journaled persistence records" << std::endl;);
+
+  try {
+    ScopedConnection conn(*connection_pool_);
+    pqxx::work txn(conn.get());
+
+    // COPY the journal tail into temp staging tables, then upsert so records
+    // the previous run did manage to insert (crash after commit, before the
+    // applied watermark advanced) are harmless duplicates
+    std::vector<const PersistenceEntry *> pending_view;
+    pending_view.reserve(pending.size());
+    for (const auto &entry : pending) {
+      pending_view.push_back(&entry);
+    }
+    copyEntries(txn, pending_view);
+
+    txn.commit();
+    journal_.markApplied(pending.size());
+
+    ENGINE_LOG_DEV(std::cout << "Journal replay complete" << std::endl;);
+  } catch (const std::exception &e) {
+    std::cerr << "Journal replay error: " << e.what()
+              << " (records remain pending)" << std::endl;
+  }
+}
+
 // Security Event Logging (SEC Regulation S-P)
 bool DatabaseManager::logSecurityEvent(const std::string &event_type,
                                        const std::string &user_id,
@@ -8,12 +8,15 @@
  */
 
 #pragma once
+#include "Journal.h"
 #include "LockFreeQueue.h"
 #include "MemoryPool.h"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -62,10 +65,15 @@ private:
   std::string connection_string_;
   size_t pool_size_;
   std::atomic<size_t> active_connections_{0};
+  // Run once per freshly opened connection (e.g. to register server-side
+  // prepared statements) before it enters the pool
+  std::function<void(pqxx::connection &)> on_connect_;
 
 public:
-  ConnectionPool(const std::string &connection_string, size_t pool_size = 5)
-      : connection_string_(connection_string), pool_size_(pool_size) {}
+  ConnectionPool(const std::string &connection_string, size_t pool_size = 5,
+                 std::function<void(pqxx::connection &)> on_connect = nullptr)
+      : connection_string_(connection_string), pool_size_(pool_size),
+        on_connect_(std::move(on_connect)) {}
 
   ~ConnectionPool() {
     std::lock_guard<std::mutex> lock(pool_mutex_);
@@ -75,9 +83,24 @@ public:
   }
 
   bool initialize() {
-    try {
-      for (size_t i = 0; i < pool_size_; ++i) {
+    // Establish all connections concurrently: the TLS and auth handshakes
+    // dominate connection setup, so the pool comes up in roughly one round
+    // trip instead of pool_size_ serial ones
+    std::vector<std::future<std::unique_ptr<pqxx::connection>>> pending;
+    pending.reserve(pool_size_);
+    for (size_t i = 0; i < pool_size_; ++i) {
+      pending.push_back(std::async(std::launch::async, [this]() {
         auto conn = std::make_unique<pqxx::connection>(connection_string_);
+        if (on_connect_) {
+          on_connect_(*conn);
+        }
+        return conn;
+      }));
+    }
+
+    try {
+      for (auto &future : pending) {
+        auto conn = future.get();
         if (!conn->is_open()) {
           return false;
         }
@@ -167,6 +190,10 @@ private:
     int64_t timestamp_ms;
 
     // Trade specific fields
+    // trade_id is generated once in persistTrade(), before journaling, so
+    // the worker, the per-row fallback, and journal replay all insert the
+    // same id and ON CONFLICT dedup actually works across restarts
+    char trade_id[64];
     char buy_order_id[50];
     char sell_order_id[50];
     char buyer_id[50];
@@ -182,7 +209,34 @@ private:
   MemoryPool<PersistenceEntry, 16384>
       persistence_pool_; // Memory pool for events
 
+  // Write-ahead journal (see Journal.h). Every persistence entry is appended
+  // to the mmap'd journal before it is enqueued, so queue-full drops and
+  // crashes before the async DB write no longer lose compliance records;
+  // connect() replays the un-applied tail into PostgreSQL via COPY.
+  BinaryJournal<PersistenceEntry> journal_;
+  static constexpr uint64_t JOURNAL_CAPACITY = 262144; // Records (~100MB)
+
   void persistenceWorker();
+  void replayJournal();
+
+  // Rows per persistenceWorker drain/COPY transaction
+  // (AUREX_PERSIST_BATCH_SIZE, default 1024)
+  size_t persist_batch_size_{1024};
+
+  // Registers the server-side prepared statements used by the persistence
+  // fallback paths; run once per pooled connection
+  static void prepareStatements(pqxx::connection &conn);
+
+  // COPYs a drained batch into temp staging tables and upserts into
+  // orders/trades; shared by persistenceWorker and replayJournal
+  void copyEntries(pqxx::work &txn,
+                   const std::vector<const PersistenceEntry *> &entries);
+
+  // Per-row fallback when a COPY batch fails: one prepared-statement
+  // transaction per entry so a single poison row cannot sink the batch
+  bool persistEntryRow(pqxx::connection &conn, const PersistenceEntry &entry);
+
+  std::string nextTradeId(const PersistenceEntry &entry);
 
   void initializeTables();
   void syncWorker();
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Memory-mapped append-only journal of fixed-size records. Used as a
+// write-ahead log in front of asynchronous PostgreSQL persistence: records
+// are appended with a plain memcpy into the mapping (sequential writes) and
+// made durable in batches with a single msync per commit(). The header
+// tracks two watermarks:
+//   committed - records durably appended to the journal
+//   applied   - records confirmed written to the database
+// On restart the [applied, committed) range is replayed into the database;
+// once applied catches up with committed the journal logically resets to
+// empty, so the file never grows past its capacity in steady state.
+//
+// append() may be called from any thread (a short mutex guards the tail);
+// commit()/markApplied() are expected from the single persistence thread.
+// On Windows the journal is disabled and all operations no-op.
+template <typename Record> class BinaryJournal {
+  static_assert(std::is_trivially_copyable<Record>::value,
+                "Journal records must be trivially copyable");
+
+private:
+  struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    uint64_t committed;
+    uint64_t applied;
+  };
+
+  static constexpr uint64_t MAGIC = 0x4155524558574C31ull; // "AUREXWL1"
+  static constexpr uint32_t VERSION = 1;
+
+#ifndef _WIN32
+  int fd_{-1};
+  uint8_t *map_{nullptr};
+  size_t map_size_{0};
+  Header *header_{nullptr};
+  Record *records_{nullptr};
+  std::mutex append_mutex_;
+#endif
+
+public:
+  BinaryJournal() = default;
+  ~BinaryJournal() { close(); }
+
+  // Non-copyable, non-movable (owns an mmap)
+  BinaryJournal(const BinaryJournal &) = delete;
+  BinaryJournal &operator=(const BinaryJournal &) = delete;
+
+#ifndef _WIN32
+  bool open(const std::string &path, uint64_t capacity) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+      std::cerr << "Journal: failed to open " << path << std::endl;
+      return false;
+    }
+
+    map_size_ = sizeof(Header) + capacity * sizeof(Record);
+
+    struct stat st;
+    bool fresh = (fstat(fd_, &st) == 0 && st.st_size == 0);
+    if (ftruncate(fd_, static_cast<off_t>(map_size_)) != 0) {
+      std::cerr << "Journal: failed to size " << path << std::endl;
+      ::close(fd_);
+      fd_ = -1;
+      return false;
+    }
+
+    void *map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd_, 0);
+    if (map == MAP_FAILED) {
+      std::cerr << "Journal: mmap failed for " << path << std::endl;
+      ::close(fd_);
+      fd_ = -1;
+      return false;
+    }
+
+    map_ = static_cast<uint8_t *>(map);
+    header_ = reinterpret_cast<Header *>(map_);
+    records_ = reinterpret_cast<Record *>(map_ + sizeof(Header));
+
+    if (fresh || header_->magic != MAGIC) {
+      header_->magic = MAGIC;
+      header_->version = VERSION;
+      header_->record_size = sizeof(Record);
+      header_->capacity = capacity;
+      header_->committed = 0;
+      header_->applied = 0;
+      msync(map_, sizeof(Header), MS_SYNC);
+    } else if (header_->record_size != sizeof(Record) ||
+               header_->capacity != capacity) {
+      // Layout changed between builds: refuse rather than misread records
+      std::cerr << "Journal: " << path << " has incompatible layout, ignoring"
+                << std::endl;
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void close() {
+    if (map_) {
+      msync(map_, map_size_, MS_SYNC);
+      munmap(map_, map_size_);
+      map_ = nullptr;
+      header_ = nullptr;
+      records_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  bool isOpen() const { return header_ != nullptr; }
+
+  // Appends one record (sequential memcpy into the mapping, no sync).
+  // Returns false when the journal is full or closed.
+  bool append(const Record &record) {
+    if (!header_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(append_mutex_);
+    if (header_->committed >= header_->capacity) {
+      return false;
+    }
+    std::memcpy(&records_[header_->committed], &record, sizeof(Record));
+    header_->committed++;
+    return true;
+  }
+
+  // Makes all appended records durable with a single msync of the dirty
+  // range plus the header. Called once per persistence batch.
+  void commit() {
+    if (!header_) {
+      return;
+    }
+    msync(map_, sizeof(Header) + header_->committed * sizeof(Record), MS_SYNC);
+  }
+
+  // Marks `count` more records as confirmed in the database. When applied
+  // catches up with committed, the journal logically resets to empty.
+  void markApplied(uint64_t count) {
+    if (!header_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(append_mutex_);
+    header_->applied += count;
+    if (header_->applied >= header_->committed) {
+      header_->applied = 0;
+      header_->committed = 0;
+    }
+    msync(map_, sizeof(Header), MS_SYNC);
+  }
+
+  uint64_t pendingCount() const {
+    return header_ ? header_->committed - header_->applied : 0;
+  }
+
+  // Copies the [applied, committed) range for replay into the database.
+  std::vector<Record> readPending() {
+    std::vector<Record> pending;
+    if (!header_) {
+      return pending;
+    }
+    std::lock_guard<std::mutex> lock(append_mutex_);
+    pending.reserve(header_->committed - header_->applied);
+    for (uint64_t i = header_->applied; i < header_->committed; ++i) {
+      pending.push_back(records_[i]);
+    }
+    return pending;
+  }
+#else
+  // Journal is POSIX-only; persistence falls back to the direct DB path
+  bool open(const std::string &, uint64_t) { return false; }
+  void close() {}
+  bool isOpen() const { return false; }
+  bool append(const Record &) { return false; }
+  void commit() {}
+  void markApplied(uint64_t) {}
+  uint64_t pendingCount() const { return 0; }
+  std::vector<Record> readPending() { return {}; }
+#endif
+};
@@ -65,6 +65,44 @@ public:
     return item;
   }
 
+  // Producer side (single thread only). Enqueues up to `count` items with a
+  // single release-store of head_; returns the number actually enqueued
+  // (limited by free space).
+  size_t enqueue_bulk(T *const *items, size_t count) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    // One slot is sacrificed to distinguish full from empty
+    const size_t free_slots = (tail - head - 1) & MASK;
+    const size_t to_enqueue = count < free_slots ? count : free_slots;
+
+    for (size_t i = 0; i < to_enqueue; ++i) {
+      buffer_[(head + i) & MASK].data.store(items[i], std::memory_order_relaxed);
+    }
+    if (to_enqueue > 0) {
+      head_.store((head + to_enqueue) & MASK, std::memory_order_release);
+    }
+    return to_enqueue;
+  }
+
+  // Consumer side (single thread only). Dequeues up to `max` items with a
+  // single release-store of tail_; returns the number dequeued.
+  size_t dequeue_bulk(T **out, size_t max) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t available = (head - tail) & MASK;
+    const size_t to_dequeue = max < available ? max : available;
+
+    for (size_t i = 0; i < to_dequeue; ++i) {
+      const size_t slot = (tail + i) & MASK;
+      out[i] = buffer_[slot].data.load(std::memory_order_relaxed);
+      buffer_[slot].data.store(nullptr, std::memory_order_relaxed);
+    }
+    if (to_dequeue > 0) {
+      tail_.store((tail + to_dequeue) & MASK, std::memory_order_release);
+    }
+    return to_dequeue;
+  }
+
   // Check if queue is empty (not thread-safe, for diagnostic only)
   bool empty() const {
     return head_.load(std::memory_order_relaxed) ==
@@ -156,4 +194,75 @@ public:
       // Loop again to try the next slot immediately.
     }
   }
+
+  // Producer side (multiple threads). Claims `count` slots with a single
+  // fetch_add on head_ instead of one per item; the per-slot ready flags are
+  // still published individually so the consumer can make progress as each
+  // slot lands. Returns the number of items actually enqueued (slots whose
+  // previous occupant never drained are skipped, as in enqueue()).
+  size_t enqueue_bulk(T *const *items, size_t count) {
+    if (count == 0) {
+      return 0;
+    }
+
+    const size_t base = head_.fetch_add(count, std::memory_order_acq_rel);
+    size_t enqueued = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+      const size_t slot = (base + i) & MASK;
+
+      int retries = 0;
+      const int MAX_RETRIES = 10000;
+      bool claimed = true;
+
+      while (buffer_[slot].ready.load(std::memory_order_acquire)) {
+        if (++retries > MAX_RETRIES) {
+          // Consumer is slow or dead: mark the slot skipped so dequeue can
+          // advance past it (same policy as enqueue())
+          buffer_[slot].data.store(nullptr, std::memory_order_relaxed);
+          buffer_[slot].ready.store(true, std::memory_order_release);
+          claimed = false;
+          break;
+        }
+        std::this_thread::yield();
+      }
+
+      if (claimed) {
+        buffer_[slot].data.store(items[i], std::memory_order_relaxed);
+        buffer_[slot].ready.store(true, std::memory_order_release);
+        enqueued++;
+      }
+    }
+    return enqueued;
+  }
+
+  // Consumer side (single thread only). Drains up to `max` ready slots with a
+  // single release-store of tail_; returns the number of (non-skipped) items
+  // written to `out`.
+  size_t dequeue_bulk(T **out, size_t max) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t consumed = 0;
+    size_t produced = 0;
+
+    while (produced < max) {
+      const size_t slot = (tail + consumed) & MASK;
+      if (!buffer_[slot].ready.load(std::memory_order_acquire)) {
+        break; // Nothing more ready
+      }
+
+      T *item = buffer_[slot].data.load(std::memory_order_relaxed);
+      buffer_[slot].data.store(nullptr, std::memory_order_relaxed);
+      buffer_[slot].ready.store(false, std::memory_order_release);
+      consumed++;
+
+      if (item) {
+        out[produced++] = item; // Skipped slots are consumed but not returned
+      }
+    }
+
+    if (consumed > 0) {
+      tail_.store((tail + consumed) & MASK, std::memory_order_release);
+    }
+    return produced;
+  }
 };
@@ -13,7 +13,10 @@
 #include <atomic>
 #include <cstddef>
 #include <cstddef>  // for offsetof
+#include <cstdint>
+#include <mutex>
 #include <new>
+#include <unordered_set>
 
 // Memory pool for fixed-size allocations
 template<typename T, size_t PoolSize = 1024>
@@ -34,11 +37,49 @@ private:
     static_assert(alignof(Block) >= alignof(Block*),
                   "Block must be properly aligned for pointer storage");
     
+    // Blocks transferred between a thread magazine and the shared list per
+    // refill/flush. Magazines hold up to twice this so alternating
+    // alloc/dealloc at the boundary doesn't thrash the shared list.
+    static constexpr size_t MAGAZINE_SIZE = 32;
+
+    // Pool identity for the magazine cache. Magazines match on this id, not
+    // the pool's address: a new pool constructed at a freed pool's address
+    // (routine for stack-allocated Stocks created and destroyed in sequence)
+    // must never adopt stale cached blocks that point into the freed arena.
+    // The live-id set lets threads discard magazines of destroyed pools.
+    static inline std::atomic<uint64_t> next_pool_id_{1};
+    static inline std::mutex live_pools_mutex_;
+    static inline std::unordered_set<uint64_t> live_pools_;
+    const uint64_t pool_id_;
+
     std::unique_ptr<Block[]> pool_;
-    std::atomic<Block*> free_list_;
+    // Shared free-list head packed as {generation tag : 32 | block index+1 : 32}.
+    // The tag increments on every successful head update, which makes the
+    // classic ABA window (pop A, concurrent pop A/push B/push A, CAS still
+    // matches) impossible and lets refills walk the chain safely: if the CAS
+    // with the old tag succeeds, the chain was untouched during the walk.
+    std::atomic<uint64_t> free_list_;
     std::atomic<size_t> allocated_count_{0};
     size_t pool_size_;
-    
+
+    uint64_t encodeHead(Block* block, uint32_t tag) const {
+        uint64_t index = block ? static_cast<uint64_t>(block - pool_.get()) + 1 : 0;
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+    Block* decodeBlock(uint64_t head) const {
+        uint64_t index = head & 0xFFFFFFFFu;
+        return index ? pool_.get() + (index - 1) : nullptr;
+    }
+
+    static uint32_t decodeTag(uint64_t head) {
+        return static_cast<uint32_t>(head >> 32);
+    }
+
+    bool isPoolBlock(const Block* block) const {
+        return block >= pool_.get() && block < pool_.get() + pool_size_;
+    }
+
     void initializeFreeList() {
         // Initialize the free list in reverse order for better cache locality
         // Now using the union's 'next' member instead of reinterpret_cast
@@ -46,16 +87,143 @@ private:
             pool_[i].next = &pool_[i - 1];
         }
         pool_[0].next = nullptr;
-        free_list_.store(&pool_[pool_size_ - 1], std::memory_order_relaxed);
+        free_list_.store(encodeHead(&pool_[pool_size_ - 1], 0), std::memory_order_relaxed);
     }
-    
+
+    // Per-thread block cache. The common-case allocate/deallocate is a plain
+    // array push/pop (plus a relaxed stats counter); the shared tagged list is
+    // touched only on refill/flush, in MAGAZINE_SIZE batches.
+    struct Magazine {
+        uint64_t owner_id;  // pool_id_ of the instance this cache belongs to
+        Magazine* next;     // Next cache on this thread (other pool instances)
+        size_t count;
+        Block* blocks[2 * MAGAZINE_SIZE];
+    };
+
+    struct ThreadMagazines {
+        Magazine* head{nullptr};
+
+        ~ThreadMagazines() {
+            // Cached blocks are abandoned on thread exit: the owning pool may
+            // already be gone, so returning them is not safe. The blocks live
+            // inside the pool's array, so this only costs capacity, and the
+            // engine's worker threads are process-lifetime anyway.
+            while (head) {
+                Magazine* next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+    };
+
+    Magazine& threadMagazine() {
+        static thread_local ThreadMagazines magazines;
+        for (Magazine* mag = magazines.head; mag; mag = mag->next) {
+            if (mag->owner_id == pool_id_) {
+                return *mag;
+            }
+        }
+
+        // First touch of this pool from this thread. Drop magazines whose
+        // pool has been destroyed - their cached blocks point into freed
+        // arenas - so sequential pool lifetimes don't grow the list.
+        {
+            std::lock_guard<std::mutex> lock(live_pools_mutex_);
+            Magazine** link = &magazines.head;
+            while (*link) {
+                if (live_pools_.count((*link)->owner_id) == 0) {
+                    Magazine* dead = *link;
+                    *link = dead->next;
+                    delete dead;
+                } else {
+                    link = &(*link)->next;
+                }
+            }
+        }
+
+        Magazine* mag = new Magazine();
+        mag->owner_id = pool_id_;
+        mag->count = 0;
+        mag->next = magazines.head;
+        magazines.head = mag;
+        return *mag;
+    }
+
+    // Pop up to MAGAZINE_SIZE blocks from the shared list with a single CAS.
+    // The walk over next pointers can race with other threads, but any
+    // concurrent head update bumps the tag and fails the CAS, so a stale walk
+    // is always discarded; the bounds check keeps it from dereferencing a
+    // block whose bytes are live object data.
+    void refillMagazine(Magazine& mag) {
+        uint64_t head = free_list_.load(std::memory_order_acquire);
+        for (;;) {
+            Block* first = decodeBlock(head);
+            if (!first) {
+                return; // Shared list exhausted
+            }
+
+            Block* last = first;
+            size_t chain_len = 1;
+            while (chain_len < MAGAZINE_SIZE && isPoolBlock(last->next)) {
+                last = last->next;
+                ++chain_len;
+            }
+            Block* remainder = (chain_len < MAGAZINE_SIZE) ? nullptr : last->next;
+            if (remainder && !isPoolBlock(remainder)) {
+                remainder = nullptr;
+            }
+
+            uint64_t new_head = encodeHead(remainder, decodeTag(head) + 1);
+            if (free_list_.compare_exchange_weak(head, new_head,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                Block* block = first;
+                for (size_t i = 0; i < chain_len; ++i) {
+                    Block* next = block->next;
+                    mag.blocks[mag.count++] = block;
+                    block = next;
+                }
+                return;
+            }
+        }
+    }
+
+    // Return MAGAZINE_SIZE blocks to the shared list as one pre-linked chain
+    // pushed with a single CAS.
+    void flushMagazine(Magazine& mag) {
+        Block* chain_head = mag.blocks[mag.count - 1];
+        Block* chain_tail = mag.blocks[mag.count - MAGAZINE_SIZE];
+        for (size_t i = 0; i < MAGAZINE_SIZE - 1; ++i) {
+            mag.blocks[mag.count - 1 - i]->next = mag.blocks[mag.count - 2 - i];
+        }
+        mag.count -= MAGAZINE_SIZE;
+
+        uint64_t head = free_list_.load(std::memory_order_acquire);
+        uint64_t new_head;
+        do {
+            chain_tail->next = decodeBlock(head);
+            new_head = encodeHead(chain_head, decodeTag(head) + 1);
+        } while (!free_list_.compare_exchange_weak(head, new_head,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+    }
+
 public:
-    explicit MemoryPool(size_t size = PoolSize) : pool_size_(size) {
+    explicit MemoryPool(size_t size = PoolSize)
+        : pool_id_(next_pool_id_.fetch_add(1, std::memory_order_relaxed)),
+          pool_size_(size) {
         pool_ = std::make_unique<Block[]>(pool_size_);
         initializeFreeList();
+        std::lock_guard<std::mutex> lock(live_pools_mutex_);
+        live_pools_.insert(pool_id_);
+    }
+
+    ~MemoryPool() {
+        // Retire the id so threads holding magazines for this pool discard
+        // them instead of recycling blocks from the freed arena
+        std::lock_guard<std::mutex> lock(live_pools_mutex_);
+        live_pools_.erase(pool_id_);
     }
-    
-    ~MemoryPool() = default;
     
     // Non-copyable, non-movable
     MemoryPool(const MemoryPool&) = delete;
@@ -63,57 +231,66 @@ public:
     MemoryPool(MemoryPool&&) = delete;
     MemoryPool& operator=(MemoryPool&&) = delete;
     
-    // Allocate object from pool
+    // Allocate object from pool. Common case is a thread-local magazine pop
+    // with no shared-list CAS.
     template<typename... Args>
     T* allocate(Args&&... args) {
-        Block* block = free_list_.load(std::memory_order_acquire);
-        
-        while (block != nullptr) {
-            // Use union's next member instead of reinterpret_cast
-            Block* next = block->next;
-            if (free_list_.compare_exchange_weak(block, next, 
-                                               std::memory_order_release, 
-                                               std::memory_order_acquire)) {
-                allocated_count_.fetch_add(1, std::memory_order_relaxed);
-                // Construct T in the block's data area (placement new)
-                return new(&block->data) T(std::forward<Args>(args)...);
-            }
+        Magazine& mag = threadMagazine();
+        if (mag.count == 0) {
+            refillMagazine(mag);
+        }
+        if (mag.count > 0) {
+            Block* block = mag.blocks[--mag.count];
+            allocated_count_.fetch_add(1, std::memory_order_relaxed);
+            // Construct T in the block's data area (placement new)
+            return new(&block->data) T(std::forward<Args>(args)...);
         }
-        
+
         // Pool exhausted, fallback to regular allocation
         // NOTE: This is tracked separately and must be handled in deallocate
         return new T(std::forward<Args>(args)...);
     }
-    
-    // Deallocate object back to pool
+
+    // Deallocate object back to pool. Common case is a thread-local magazine
+    // push; a full magazine flushes half its blocks back to the shared list
+    // as one chain.
     void deallocate(T* ptr) {
         if (!ptr) return;
-        
+
         // Calculate the Block* from T* (ptr points to the data member in the union)
         Block* block = reinterpret_cast<Block*>(
             reinterpret_cast<char*>(ptr) - offsetof(Block, data)
         );
-        
+
         // Check if pointer is within our pool range
-        if (block >= pool_.get() && block < pool_.get() + pool_size_) {
+        if (isPoolBlock(block)) {
             // Call destructor
             ptr->~T();
-            
-            // Add back to free list using union's next member
-            Block* head = free_list_.load(std::memory_order_acquire);
-            do {
-                block->next = head;
-            } while (!free_list_.compare_exchange_weak(head, block,
-                                                     std::memory_order_release,
-                                                     std::memory_order_acquire));
-            
+
+            Magazine& mag = threadMagazine();
+            if (mag.count == 2 * MAGAZINE_SIZE) {
+                flushMagazine(mag);
+            }
+            mag.blocks[mag.count++] = block;
             allocated_count_.fetch_sub(1, std::memory_order_relaxed);
         } else {
             // Was allocated outside pool, use regular delete
             delete ptr;
         }
     }
-    
+
+    // Fault in the arena's pages on the calling thread so the first orders
+    // of the session don't pay them. Reads one byte per page through a
+    // volatile pointer; the free-list links live in the same bytes, so
+    // nothing is written.
+    void prewarm() const {
+        const volatile char* base = reinterpret_cast<const volatile char*>(pool_.get());
+        const size_t bytes = pool_size_ * sizeof(Block);
+        for (size_t offset = 0; offset < bytes; offset += 4096) {
+            (void)base[offset];
+        }
+    }
+
     // Statistics
     size_t allocated_count() const {
         return allocated_count_.load(std::memory_order_relaxed);
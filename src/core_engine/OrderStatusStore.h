@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <absl/container/flat_hash_map.h>
+#include "../common/InternTable.h"
+
+// Sharded order status store replacing the old single std::mutex +
+// std::map<std::string, Order> cache.
+//
+// Sixteen shards keyed by a hash of the order id. Each shard owns a flat
+// hash index from order id to a slot in a std::deque slab, so records have
+// stable addresses all day. The shard mutex guards only the index probe and
+// slab growth; every record carries its own seqlock, so a status update is a
+// handful of plain stores between two version bumps and an OMS poller copies
+// the fixed-size record without ever blocking matching — no Order copy, no
+// string work, no shared mutex with the fill path.
+//
+// Records are stamped with a day epoch. When the day rolls over, the next
+// insert into a shard sweeps that shard's terminal records back onto a free
+// list, so the store stops growing without bound across sessions.
+class OrderStatusStore {
+public:
+    enum class State : uint8_t {
+        PENDING = 0,    // Accepted by ingress, not yet seen by matching
+        OPEN,
+        PARTIAL,
+        FILLED,
+        CANCELLED,
+        CANCEL_PENDING, // Cancel submitted, not yet processed
+        REJECTED
+    };
+
+    static bool isTerminal(State state) {
+        return state == State::FILLED || state == State::CANCELLED ||
+               state == State::REJECTED;
+    }
+
+    // Fixed-size status record. The order id lives in the shard index and
+    // the user comes back through the intern table, so the update path never
+    // touches a string.
+    struct Record {
+        std::atomic<uint32_t> seq{0};  // Seqlock version; odd while a write is in flight
+        uint32_t epoch{0};             // Day stamp for recycling
+        State state{State::PENDING};
+        uint8_t side{0};
+        uint8_t type{0};
+        UserHandle user_handle{INVALID_USER_HANDLE};
+        int64_t quantity{0};
+        int64_t remaining_qty{0};
+        int64_t price{0};       // Fixed-point cents (Price)
+        int64_t fill_price{0};  // Last execution price, cents (0 = no fills)
+        int64_t timestamp_ms{0};
+
+        Record() = default;
+        Record(const Record&) = delete;
+        Record& operator=(const Record&) = delete;
+    };
+
+    // Plain copy of a record's payload, taken under the seqlock
+    struct Snapshot {
+        State state{State::PENDING};
+        uint8_t side{0};
+        uint8_t type{0};
+        UserHandle user_handle{INVALID_USER_HANDLE};
+        int64_t quantity{0};
+        int64_t remaining_qty{0};
+        int64_t price{0};
+        int64_t fill_price{0};
+        int64_t timestamp_ms{0};
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr int64_t MS_PER_DAY = 86'400'000;
+
+    // Looks up a record; nullptr when the id was never admitted (or was
+    // recycled by a day-epoch sweep). The pointer stays valid until such a
+    // sweep, which only reclaims terminal records from previous days.
+    Record* find(const std::string& order_id) {
+        Shard& shard = shardFor(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(order_id);
+        return (it == shard.index.end()) ? nullptr : &shard.slab[it->second];
+    }
+
+    // Finds or creates the record for an id. New records start as PENDING
+    // with a zeroed payload; the caller publishes the real fields through
+    // beginWrite/endWrite. Runs the day-epoch sweep for the shard.
+    Record* findOrCreate(const std::string& order_id, int64_t now_ms) {
+        const uint32_t epoch = epochOf(now_ms);
+        Shard& shard = shardFor(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        sweepLocked(shard, epoch);
+
+        auto it = shard.index.find(order_id);
+        if (it != shard.index.end()) {
+            return &shard.slab[it->second];
+        }
+
+        uint32_t slot;
+        if (!shard.free_slots.empty()) {
+            slot = shard.free_slots.back();
+            shard.free_slots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(shard.slab.size());
+            shard.slab.emplace_back();
+        }
+        shard.index.emplace(order_id, slot);
+
+        Record& rec = shard.slab[slot];
+        uint32_t seq = beginWrite(rec);
+        rec.epoch = epoch;
+        rec.state = State::PENDING;
+        rec.side = 0;
+        rec.type = 0;
+        rec.user_handle = INVALID_USER_HANDLE;
+        rec.quantity = 0;
+        rec.remaining_qty = 0;
+        rec.price = 0;
+        rec.fill_price = 0;
+        rec.timestamp_ms = now_ms;
+        endWrite(rec, seq);
+        return &rec;
+    }
+
+    // Rolls back an admit whose enqueue failed: drops the record only if it
+    // is still PENDING (matching has not seen the order).
+    void dropIfPending(const std::string& order_id) {
+        Shard& shard = shardFor(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(order_id);
+        if (it == shard.index.end()) {
+            return;
+        }
+        Record& rec = shard.slab[it->second];
+        if (read(rec).state != State::PENDING) {
+            return;
+        }
+        shard.free_slots.push_back(it->second);
+        shard.index.erase(it);
+    }
+
+    // Seqlock read: wait-free payload copy, retried on a torn read
+    static Snapshot read(const Record& rec) {
+        Snapshot out;
+        for (;;) {
+            uint32_t v1 = rec.seq.load(std::memory_order_acquire);
+            if (v1 & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            out.state = rec.state;
+            out.side = rec.side;
+            out.type = rec.type;
+            out.user_handle = rec.user_handle;
+            out.quantity = rec.quantity;
+            out.remaining_qty = rec.remaining_qty;
+            out.price = rec.price;
+            out.fill_price = rec.fill_price;
+            out.timestamp_ms = rec.timestamp_ms;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (rec.seq.load(std::memory_order_relaxed) == v1) {
+                return out;
+            }
+        }
+    }
+
+    // Seqlock write acquisition. Both ingress (pending / cancel_pending) and
+    // the matching thread write records, so the odd version doubles as a
+    // per-record spinlock; the uncontended cost is one CAS plus one store.
+    static uint32_t beginWrite(Record& rec) {
+        uint32_t s = rec.seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if (s & 1) {
+                std::this_thread::yield();
+                s = rec.seq.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (rec.seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+                return s + 1;
+            }
+        }
+    }
+
+    static void endWrite(Record& rec, uint32_t seq) {
+        rec.seq.store(seq + 1, std::memory_order_release);
+    }
+
+    static uint32_t epochOf(int64_t now_ms) {
+        return static_cast<uint32_t>(now_ms / MS_PER_DAY);
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        absl::flat_hash_map<std::string, uint32_t> index;
+        std::deque<Record> slab;  // Stable addresses; slots recycled via free_slots
+        std::vector<uint32_t> free_slots;
+        uint32_t swept_epoch{0};
+    };
+
+    Shard& shardFor(const std::string& order_id) {
+        return shards_[std::hash<std::string>{}(order_id) % SHARD_COUNT];
+    }
+
+    // Day rolled over: return terminal records from previous days to the
+    // free list. Live (non-terminal) records survive regardless of age.
+    void sweepLocked(Shard& shard, uint32_t epoch) {
+        if (epoch == shard.swept_epoch) {
+            return;
+        }
+        for (auto it = shard.index.begin(); it != shard.index.end();) {
+            Record& rec = shard.slab[it->second];
+            if (isTerminal(read(rec).state) && rec.epoch < epoch) {
+                shard.free_slots.push_back(it->second);
+                shard.index.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+        shard.swept_epoch = epoch;
+    }
+
+    std::array<Shard, SHARD_COUNT> shards_;
+};
@@ -10,6 +10,7 @@
 #define NOMINMAX
 #include "Stock.h"
 #include "../common/EngineLogging.h"
+#include "../common/EngineTelemetry.h"
 #include <random>
 #include <algorithm>
 #include <iostream>
@@ -19,19 +20,46 @@
 #include <cmath>
 #include <utility>
 
-Stock::Stock(const std::string& symbol, double initial_price, 
-             int matching_core, int md_core, int trade_core) 
-    : symbol_(symbol), last_price_(static_cast<Price>(initial_price * 100.0)), volume_(0), 
-      open_price_(static_cast<Price>(initial_price * 100.0)), 
-      day_high_(static_cast<Price>(initial_price * 100.0)), 
-      day_low_(static_cast<Price>(initial_price * 100.0)),
-      vwap_(initial_price), total_value_traded_(0.0), running_(false),
+Stock::Stock(const std::string& symbol, double initial_price,
+             int matching_core, int md_core, int trade_core,
+             StockThreadingMode threading_mode)
+    : symbol_(symbol),
+      stats_slot_(DailyStatsBoard::slotFor(InternTable::symbols().intern(symbol))),
+      last_price_(DailyStatsBoard::instance().last(stats_slot_)),
+      volume_(DailyStatsBoard::instance().volume(stats_slot_)),
+      open_price_(DailyStatsBoard::instance().open(stats_slot_)),
+      day_high_(DailyStatsBoard::instance().high(stats_slot_)),
+      day_low_(DailyStatsBoard::instance().low(stats_slot_)),
+      running_(false),
+      threading_mode_(threading_mode),
       best_bid_(nullptr), best_ask_(nullptr),
-      matching_engine_core_(matching_core), market_data_core_(md_core), 
+      matching_engine_core_(matching_core), market_data_core_(md_core),
       trade_publisher_core_(trade_core),
       orders_processed_(0), trades_executed_(0), messages_sent_(0),
-    last_bids_snapshot_time_ms_(0), last_asks_snapshot_time_ms_(0),
     market_data_update_counter_(0) {
+    // Reset this symbol's stats slot for the new session
+    const Price initial = static_cast<Price>(initial_price * 100.0);
+    last_price_.store(initial, std::memory_order_relaxed);
+    open_price_.store(initial, std::memory_order_relaxed);
+    day_high_.store(initial, std::memory_order_relaxed);
+    day_low_.store(initial, std::memory_order_relaxed);
+    volume_.store(0, std::memory_order_relaxed);
+
+    // Default to the book depth cap; callers with a known daily profile can
+    // re-reserve via reserveOrderCapacity() before start()
+    orders_.reserve(2 * MAX_ORDER_BOOK_DEPTH);
+}
+
+void Stock::reserveOrderCapacity(size_t expected_orders) {
+    orders_.reserve(expected_orders);
+}
+
+void Stock::prewarmPools() {
+    order_pool_.prewarm();
+    price_level_pool_.prewarm();
+    order_message_pool_.prewarm();
+    trade_message_pool_.prewarm();
+    market_data_message_pool_.prewarm();
 }
 
 void Stock::setTradeCallback(TradeCallback callback) {
@@ -42,6 +70,8 @@ void Stock::setTradeCallback(TradeCallback callback) {
 void Stock::setOrderStatusCallback(OrderStatusCallback callback) {
     std::lock_guard<std::mutex> lock(order_status_callback_mutex_);
     order_status_callback_ = std::move(callback);
+    has_order_status_callback_.store(static_cast<bool>(order_status_callback_),
+                                     std::memory_order_release);
 }
 
 void Stock::setReservationHandlers(OrderReserveCallback reserve_cb, OrderReleaseCallback release_cb) {
@@ -55,7 +85,14 @@ Stock::~Stock() {
 
 void Stock::start() {
     running_.store(true, std::memory_order_release);
-    
+
+    if (threading_mode_ == StockThreadingMode::SHARDED) {
+        // No dedicated threads - a shard worker in StockExchange drives the
+        // queues through the pump*() methods
+        ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Started in sharded mode (no dedicated threads)" << std::endl;);
+        return;
+    }
+
     // Start worker threads with CPU affinity
     matching_thread_ = std::thread(&Stock::matchingEngineWorker, this);
     market_data_thread_ = std::thread(&Stock::marketDataWorker, this);
@@ -76,7 +113,12 @@ void Stock::start() {
 
 void Stock::stop() {
     running_.store(false, std::memory_order_seq_cst);  // Stronger memory ordering
-    
+
+    if (threading_mode_ == StockThreadingMode::SHARDED) {
+        // Nothing to join - the owning shard worker drains our queues on exit
+        return;
+    }
+
     ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Stopping threads..." << std::flush;);
     
     // Join threads with timeout protection to prevent indefinite hangs
@@ -167,15 +209,9 @@ std::string Stock::submitOrder(const Order& order) {
     }
 
     // Reject duplicate order IDs that are still active
-    {
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        auto it = order_status_cache_.find(order.order_id);
-        if (it != order_status_cache_.end()) {
-            const std::string& status = it->second.status;
-            const bool is_rejected = status.rfind("rejected", 0) == 0;
-            if (!is_rejected && status != "filled" && status != "cancelled") {
-                return "rejected: duplicate order_id";
-            }
+    if (OrderStatusStore::Record* existing = order_status_store_.find(order.order_id)) {
+        if (!OrderStatusStore::isTerminal(OrderStatusStore::read(*existing).state)) {
+            return "rejected: duplicate order_id";
         }
     }
 
@@ -209,70 +245,179 @@ std::string Stock::submitOrder(const Order& order) {
     // Allocate message from pool (lock-free)
     OrderMessage* msg = order_message_pool_.allocate(OrderMessage::NEW_ORDER, order);
 
+    // Backfill interned handles for orders arriving from edges that have not
+    // resolved them yet (tests, legacy callers). The TCP/shared-memory edges
+    // resolve these once per session so this is a no-op on the hot path.
+    if (msg->order.user_handle == INVALID_USER_HANDLE) {
+        msg->order.user_handle = static_cast<UserHandle>(InternTable::users().intern(order.user_id));
+    }
+    if (msg->order.symbol_handle == INVALID_SYMBOL_HANDLE) {
+        msg->order.symbol_handle = static_cast<SymbolHandle>(InternTable::symbols().intern(symbol_));
+    }
+    if (msg->order.order_seq == 0) {
+        msg->order.order_seq = nextOrderSequence();
+    }
+
     // Track pending status so cancels can find the order immediately
+    // (msg->order carries the backfilled handles, so the record can resolve
+    // the user through the intern table later)
     {
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        Order pending_copy = order;
+        Order pending_copy = msg->order;
         pending_copy.status = "pending";
         pending_copy.remaining_qty = order.quantity;
-        order_status_cache_[order.order_id] = pending_copy;
+        publishOrderStatus(pending_copy);
     }
-    
+
     if (!order_queue_.enqueue(msg)) {
         order_message_pool_.deallocate(msg);
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        auto it = order_status_cache_.find(order.order_id);
-        if (it != order_status_cache_.end() && it->second.status == "pending") {
-            order_status_cache_.erase(it);
-        }
+        order_status_store_.dropIfPending(order.order_id);
         if (reservation_acquired && release_callback_) {
             release_callback_(order, "queue_full");
         }
         return "Queue full - order rejected";
     }
-    
+
+    // Unpark the matching consumer if it is dozing in IDLE/LOW
+    matching_wake_target_->notifyWork();
+
     return "accepted";
 }
 
 std::string Stock::cancelOrder(const std::string& order_id) {
     // Check if order exists before submitting cancel
+    OrderStatusStore::Record* rec = order_status_store_.find(order_id);
+    if (rec == nullptr) {
+        return "Order not found - cancel rejected";
+    }
     {
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        auto it = order_status_cache_.find(order_id);
-        if (it == order_status_cache_.end()) {
-            return "Order not found - cancel rejected";
-        }
+        uint32_t seq = OrderStatusStore::beginWrite(*rec);
+        OrderStatusStore::State state = rec->state;
         // Check if order is already in a terminal state
-        if (it->second.status == "filled" || it->second.status == "cancelled") {
-            return "Order already " + it->second.status + " - cancel rejected";
+        if (state == OrderStatusStore::State::FILLED ||
+            state == OrderStatusStore::State::CANCELLED) {
+            OrderStatusStore::endWrite(*rec, seq);
+            const char* name = (state == OrderStatusStore::State::FILLED) ? "filled" : "cancelled";
+            return std::string("Order already ") + name + " - cancel rejected";
         }
-        it->second.status = "cancel_pending";
+        rec->state = OrderStatusStore::State::CANCEL_PENDING;
+        OrderStatusStore::endWrite(*rec, seq);
     }
-    
+
     OrderMessage* msg = order_message_pool_.allocate(OrderMessage::CANCEL_ORDER, order_id);
-    
+
     if (!order_queue_.enqueue(msg)) {
         order_message_pool_.deallocate(msg);
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        auto it = order_status_cache_.find(order_id);
-        if (it != order_status_cache_.end() && it->second.status == "cancel_pending") {
-            it->second.status = "open";
+        uint32_t seq = OrderStatusStore::beginWrite(*rec);
+        if (rec->state == OrderStatusStore::State::CANCEL_PENDING) {
+            rec->state = OrderStatusStore::State::OPEN;
         }
+        OrderStatusStore::endWrite(*rec, seq);
         return "Queue full - cancel rejected";
     }
-    
+
+    matching_wake_target_->notifyWork();
+
     return "cancel submitted";
 }
 
+std::string Stock::cancelAllForUser(const std::string& user_id) {
+    // Resolve the user at the edge; an unknown handle means this user never
+    // traded here, so there is nothing to pull
+    uint32_t handle = InternTable::users().find(user_id);
+    if (handle == INVALID_USER_HANDLE) {
+        return "User unknown - nothing to cancel";
+    }
+
+    OrderMessage* msg = order_message_pool_.allocate(
+        OrderMessage::CANCEL_ALL_FOR_USER, static_cast<UserHandle>(handle));
+
+    if (!order_queue_.enqueue(msg)) {
+        order_message_pool_.deallocate(msg);
+        return "Queue full - cancel all rejected";
+    }
+
+    matching_wake_target_->notifyWork();
+
+    return "cancel all submitted";
+}
+
+namespace {
+
+OrderStatusStore::State stateFromStatus(const std::string& status) {
+    if (status == "open" || status == "accepted") return OrderStatusStore::State::OPEN;
+    if (status == "partial") return OrderStatusStore::State::PARTIAL;
+    if (status == "filled") return OrderStatusStore::State::FILLED;
+    if (status == "cancelled") return OrderStatusStore::State::CANCELLED;
+    if (status == "cancel_pending") return OrderStatusStore::State::CANCEL_PENDING;
+    if (status == "pending") return OrderStatusStore::State::PENDING;
+    if (status.rfind("rejected", 0) == 0) return OrderStatusStore::State::REJECTED;
+    return OrderStatusStore::State::OPEN;
+}
+
+const char* statusString(OrderStatusStore::State state) {
+    switch (state) {
+        case OrderStatusStore::State::PENDING:        return "pending";
+        case OrderStatusStore::State::OPEN:           return "open";
+        case OrderStatusStore::State::PARTIAL:        return "partial";
+        case OrderStatusStore::State::FILLED:         return "filled";
+        case OrderStatusStore::State::CANCELLED:      return "cancelled";
+        case OrderStatusStore::State::CANCEL_PENDING: return "cancel_pending";
+        case OrderStatusStore::State::REJECTED:       return "rejected";
+    }
+    return "open";
+}
+
+} // namespace
+
+// Publishes an order's current state into the status store. Called from the
+// matching thread on every transition (and from ingress for the pending
+// record); two version bumps around plain stores, no strings copied.
+void Stock::publishOrderStatus(const Order& order) {
+    OrderStatusStore::Record* rec =
+        order_status_store_.findOrCreate(order.order_id, order.timestamp_ms);
+
+    OrderStatusStore::State state = stateFromStatus(order.status);
+    uint32_t seq = OrderStatusStore::beginWrite(*rec);
+    rec->epoch = OrderStatusStore::epochOf(order.timestamp_ms);
+    rec->state = state;
+    rec->side = static_cast<uint8_t>(order.side);
+    rec->type = static_cast<uint8_t>(order.type);
+    rec->user_handle = order.user_handle;
+    rec->quantity = order.quantity;
+    rec->remaining_qty = order.remaining_qty;
+    rec->price = order.price;
+    if (state == OrderStatusStore::State::PARTIAL ||
+        state == OrderStatusStore::State::FILLED) {
+        // Market orders carry no limit price; fall back to the last trade
+        rec->fill_price = (order.price > 0)
+            ? order.price
+            : last_price_.load(std::memory_order_relaxed);
+    }
+    rec->timestamp_ms = order.timestamp_ms;
+    OrderStatusStore::endWrite(*rec, seq);
+}
+
 Order Stock::getOrderStatus(const std::string& order_id) {
-    std::lock_guard<std::mutex> lock(order_status_mutex_);
-    
-    auto it = order_status_cache_.find(order_id);
-    if (it != order_status_cache_.end()) {
-        return it->second;
+    OrderStatusStore::Record* rec = order_status_store_.find(order_id);
+    if (rec == nullptr) {
+        return Order{}; // Order not found
     }
-    
-    return Order{}; // Order not found
+
+    OrderStatusStore::Snapshot snap = OrderStatusStore::read(*rec);
+
+    Order result{};
+    result.order_id = order_id;
+    result.user_id = InternTable::users().resolve(snap.user_handle);
+    result.symbol = symbol_;
+    result.user_handle = snap.user_handle;
+    result.side = snap.side;
+    result.type = snap.type;
+    result.quantity = snap.quantity;
+    result.remaining_qty = snap.remaining_qty;
+    result.price = snap.price;
+    result.timestamp_ms = snap.timestamp_ms;
+    result.status = statusString(snap.state);
+    return result;
 }
 
 void Stock::matchingEngineWorker() {
@@ -287,58 +432,21 @@ void Stock::matchingEngineWorker() {
     while (true) {
         if (!running_.load(std::memory_order_seq_cst)) {
             // Fast drain of any remaining work without processing to honour shutdown
-            int drained = 0;
-            OrderMessage* pending;
-            while ((pending = order_queue_.dequeue()) != nullptr) {
-                if (pending->type == OrderMessage::NEW_ORDER) {
-                    if (release_callback_) {
-                        release_callback_(pending->order, "engine_shutdown");
-                    }
-                    std::lock_guard<std::mutex> lock(order_status_mutex_);
-                    order_status_cache_.erase(pending->order.order_id);
-                }
-                order_message_pool_.deallocate(pending);
-                drained++;
-                // Check periodically if we need to exit immediately
-                if (drained % 100 == 0 && drained > 0) {
-                    ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Drained " << drained << " orders..." << std::endl;);
-                }
-            }
-            if (drained > 0) {
-                ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Drained total " << drained << " orders on shutdown" << std::endl;);
-            }
+            drainOrderQueueOnShutdown();
             break;
         }
 
+        // Capture the wake token before the empty poll so a submit racing
+        // with the park still wakes us (see AdaptiveLoadManager::prepareWait)
+        uint32_t wake_token = matching_load_manager_.prepareWait();
+
         // Process incoming orders (lock-free)
-        OrderMessage* msg = order_queue_.dequeue();
-        bool did_work = (msg != nullptr);
-        
-        if (msg) {
-            switch (msg->type) {
-                case OrderMessage::NEW_ORDER:
-                    processNewOrder(msg->order);
-                    break;
-                case OrderMessage::CANCEL_ORDER:
-                    processCancelOrder(msg->cancel_order_id);
-                    break;
-                default:
-                    break;
-            }
-            
-            order_message_pool_.deallocate(msg);
-            orders_processed_.fetch_add(1, std::memory_order_relaxed);
-        }
-        
-        // Update market data periodically (using per-instance counter to avoid data race)
-        if (++market_data_update_counter_ % 1000 == 0) {
-            updateMarketData();
-        }
-        
+        bool did_work = pumpMatching();
+
         // Adaptive load-based CPU management
         matching_load_manager_.recordIteration(did_work);
         if (!did_work) {
-            matching_load_manager_.waitForWork();
+            matching_load_manager_.waitForWork(wake_token);
         }
     }
     
@@ -363,20 +471,14 @@ void Stock::marketDataWorker() {
             break;
         }
 
-        MarketDataMessage* msg = market_data_queue_.dequeue();
-        bool did_work = (msg != nullptr);
-        
-        if (msg) {
-            // Broadcast market data to subscribers
-            // In production, this would publish to market data feeds
-            messages_sent_.fetch_add(1, std::memory_order_relaxed);
-            market_data_message_pool_.deallocate(msg);
-        }
-        
+        uint32_t wake_token = market_data_load_manager_.prepareWait();
+
+        bool did_work = pumpMarketData();
+
         // Adaptive load-based CPU management
         market_data_load_manager_.recordIteration(did_work);
         if (!did_work) {
-            market_data_load_manager_.waitForWork();
+            market_data_load_manager_.waitForWork(wake_token);
         }
     }
     
@@ -401,31 +503,14 @@ void Stock::tradePublisherWorker() {
             break;
         }
 
-        TradeMessage* msg = trade_queue_.dequeue();
-        bool did_work = (msg != nullptr);
-        
-        if (msg) {
-            // Publish trade to external systems
-            ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Trade: "
-                                     << msg->trade.quantity << "@" << msg->trade.price << std::endl;);
-            
-            trades_executed_.fetch_add(1, std::memory_order_relaxed);
-            
-            // Notify trade observer (e.g., for account settlement)
-            {
-                std::lock_guard<std::mutex> lock(trade_callback_mutex_);
-                if (trade_callback_) {
-                    trade_callback_(msg->trade);
-                }
-            }
-            
-            trade_message_pool_.deallocate(msg);
-        }
-        
+        uint32_t wake_token = trade_publisher_load_manager_.prepareWait();
+
+        bool did_work = pumpTradePublisher();
+
         // Adaptive load-based CPU management
         trade_publisher_load_manager_.recordIteration(did_work);
         if (!did_work) {
-            trade_publisher_load_manager_.waitForWork();
+            trade_publisher_load_manager_.waitForWork(wake_token);
         }
     }
     
@@ -433,6 +518,157 @@ void Stock::tradePublisherWorker() {
                              << trade_publisher_load_manager_.getLoadLevelName() << std::endl;);
 }
 
+bool Stock::pumpMatching() {
+    // Bulk dequeue amortizes the queue's atomic traffic across the burst
+    OrderMessage* batch[QUEUE_BATCH_SIZE];
+    size_t count = order_queue_.dequeue_bulk(batch, QUEUE_BATCH_SIZE);
+
+    for (size_t i = 0; i < count; ++i) {
+        OrderMessage* msg = batch[i];
+        switch (msg->type) {
+            case OrderMessage::NEW_ORDER: {
+                // Per-stage latency for sampled orders: queue wait (ingress
+                // stamp -> here) and match time (here -> done)
+                uint64_t dequeue_tsc = 0;
+                if (msg->order.ingress_tsc != 0) {
+                    dequeue_tsc = engine_clock::cycles();
+                    EngineTelemetry::instance().recordQueueWait(
+                        engine_clock::cyclesToUs(dequeue_tsc - msg->order.ingress_tsc));
+                }
+                processNewOrder(msg->order);
+                if (dequeue_tsc != 0) {
+                    EngineTelemetry::instance().recordMatchTime(
+                        engine_clock::cyclesToUs(engine_clock::cycles() - dequeue_tsc));
+                }
+                break;
+            }
+            case OrderMessage::CANCEL_ORDER:
+                processCancelOrder(msg->cancel_order_id);
+                break;
+            case OrderMessage::CANCEL_ALL_FOR_USER:
+                processCancelAllForUser(msg->cancel_user_handle);
+                break;
+            default:
+                break;
+        }
+
+        order_message_pool_.deallocate(msg);
+    }
+    if (count > 0) {
+        orders_processed_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // Update market data periodically (using per-instance counter to avoid data race)
+    market_data_update_counter_ += (count > 0) ? count : 1;
+    if (market_data_update_counter_ >= 1000) {
+        market_data_update_counter_ = 0;
+        updateMarketData();
+    }
+
+    return count > 0;
+}
+
+bool Stock::pumpMarketData() {
+    MarketDataMessage* batch[QUEUE_BATCH_SIZE];
+    size_t count = market_data_queue_.dequeue_bulk(batch, QUEUE_BATCH_SIZE);
+    if (count == 0) {
+        return false;
+    }
+
+    // Broadcast market data to subscribers
+    // In production, this would publish to market data feeds
+    messages_sent_.fetch_add(count, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        market_data_message_pool_.deallocate(batch[i]);
+    }
+    return true;
+}
+
+bool Stock::pumpTradePublisher() {
+    TradeMessage* batch[QUEUE_BATCH_SIZE];
+    size_t count = trade_queue_.dequeue_bulk(batch, QUEUE_BATCH_SIZE);
+    if (count == 0) {
+        return false;
+    }
+
+    // Snapshot the callbacks once per drained batch instead of taking a
+    // mutex per message; registration is rare, delivery is not
+    TradeCallback trade_callback;
+    {
+        std::lock_guard<std::mutex> lock(trade_callback_mutex_);
+        trade_callback = trade_callback_;
+    }
+    OrderStatusCallback status_callback;
+    {
+        std::lock_guard<std::mutex> lock(order_status_callback_mutex_);
+        status_callback = order_status_callback_;
+    }
+
+    uint64_t trades_in_batch = 0;
+    for (size_t i = 0; i < count; ++i) {
+        TradeMessage* msg = batch[i];
+
+        if (msg->kind == TradeMessage::ORDER_STATUS) {
+            // SEC Compliance: status persistence, delivered off the matching thread
+            if (status_callback) {
+                status_callback(msg->order_status);
+            }
+        } else {
+            // Publish trade to external systems
+            ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Trade: "
+                                     << msg->trade.quantity << "@" << msg->trade.price << std::endl;);
+
+            // Notify trade observer (e.g., for account settlement)
+            if (trade_callback) {
+                trade_callback(msg->trade);
+            }
+            ++trades_in_batch;
+        }
+
+        trade_message_pool_.deallocate(msg);
+    }
+    if (trades_in_batch > 0) {
+        trades_executed_.fetch_add(trades_in_batch, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void Stock::drainOrderQueueOnShutdown() {
+    int drained = 0;
+    OrderMessage* pending;
+    while ((pending = order_queue_.dequeue()) != nullptr) {
+        if (pending->type == OrderMessage::NEW_ORDER) {
+            if (release_callback_) {
+                release_callback_(pending->order, "engine_shutdown");
+            }
+            order_status_store_.dropIfPending(pending->order.order_id);
+        }
+        order_message_pool_.deallocate(pending);
+        drained++;
+        // Check periodically if we need to exit immediately
+        if (drained % 100 == 0 && drained > 0) {
+            ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Drained " << drained << " orders..." << std::endl;);
+        }
+    }
+    if (drained > 0) {
+        ENGINE_LOG_DEV(std::cout << "[" << symbol_ << "] Drained total " << drained << " orders on shutdown" << std::endl;);
+    }
+}
+
+void Stock::drainShutdown() {
+    // Called by the owning shard worker after running_ went false. Mirrors
+    // what the three dedicated workers do on exit: release queued orders and
+    // discard unpublished trade/market-data messages.
+    drainOrderQueueOnShutdown();
+
+    while (MarketDataMessage* pending = market_data_queue_.dequeue()) {
+        market_data_message_pool_.deallocate(pending);
+    }
+    while (TradeMessage* pending = trade_queue_.dequeue()) {
+        trade_message_pool_.deallocate(pending);
+    }
+}
+
 void Stock::processNewOrder(const Order& incoming_order) {
     // Check order book depth limits
     size_t current_buys = total_buy_orders_.load(std::memory_order_relaxed);
@@ -442,11 +678,10 @@ void Stock::processNewOrder(const Order& incoming_order) {
         // Buy side full, reject order
         std::cerr << "Order book depth limit reached for buy side: " << symbol_ << std::endl;
         {
-            std::lock_guard<std::mutex> lock(order_status_mutex_);
             Order rejected = incoming_order;
             rejected.status = "rejected: buy book depth limit reached";
             rejected.remaining_qty = 0;
-            order_status_cache_[incoming_order.order_id] = rejected;
+            publishOrderStatus(rejected);
         }
         if (release_callback_) {
             release_callback_(incoming_order, "rejected: buy book depth limit reached");
@@ -457,11 +692,10 @@ void Stock::processNewOrder(const Order& incoming_order) {
         // Sell side full, reject order
         std::cerr << "Order book depth limit reached for sell side: " << symbol_ << std::endl;
         {
-            std::lock_guard<std::mutex> lock(order_status_mutex_);
             Order rejected = incoming_order;
             rejected.status = "rejected: sell book depth limit reached";
             rejected.remaining_qty = 0;
-            order_status_cache_[incoming_order.order_id] = rejected;
+            publishOrderStatus(rejected);
         }
         if (release_callback_) {
             release_callback_(incoming_order, "rejected: sell book depth limit reached");
@@ -474,11 +708,10 @@ void Stock::processNewOrder(const Order& incoming_order) {
     
     if (orders_.find(order->order_id) != orders_.end()) {
         {
-            std::lock_guard<std::mutex> lock(order_status_mutex_);
             Order rejected = incoming_order;
             rejected.status = "rejected: duplicate order_id";
             rejected.remaining_qty = 0;
-            order_status_cache_[incoming_order.order_id] = rejected;
+            publishOrderStatus(rejected);
         }
         if (release_callback_) {
             release_callback_(incoming_order, "rejected: duplicate order_id");
@@ -488,12 +721,9 @@ void Stock::processNewOrder(const Order& incoming_order) {
     }
     
     orders_[order->order_id] = order;
-    
-    // Update order status cache (thread-safe)
-    {
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        order_status_cache_[order->order_id] = *order;
-    }
+
+    // Publish open status
+    publishOrderStatus(*order);
     
     std::vector<Trade> trades;
     {
@@ -513,7 +743,7 @@ void Stock::processNewOrder(const Order& incoming_order) {
                         }
                         Order* maker = level->first_order;
                         while (maker && remaining > 0) {
-                            if (maker->user_id != order->user_id) {
+                            if (maker->user_handle != order->user_handle) {
                                 remaining -= maker->remaining_qty;
                             }
                             maker = maker->next_at_price;
@@ -528,7 +758,7 @@ void Stock::processNewOrder(const Order& incoming_order) {
                         }
                         Order* maker = level->first_order;
                         while (maker && remaining > 0) {
-                            if (maker->user_id != order->user_id) {
+                            if (maker->user_handle != order->user_handle) {
                                 remaining -= maker->remaining_qty;
                             }
                             maker = maker->next_at_price;
@@ -564,10 +794,7 @@ void Stock::processNewOrder(const Order& incoming_order) {
         }
 
         if (order != nullptr && order->remaining_qty == 0) {
-            {
-                std::lock_guard<std::mutex> lock(order_status_mutex_);
-                order_status_cache_[order->order_id] = *order;
-            }
+            publishOrderStatus(*order);
             Order release_snapshot = *order;
             if (release_reason.empty()) {
                 release_reason = release_snapshot.status;
@@ -579,22 +806,29 @@ void Stock::processNewOrder(const Order& incoming_order) {
             order_pool_.deallocate(order);
             order = nullptr;
         }
+
+        publishDepthSnapshot();
     }
-    
-    // Update order status cache after matching (only if order still exists)
+
+    // Publish order status after matching (only if order still exists)
     if (order != nullptr) {
-        std::lock_guard<std::mutex> lock(order_status_mutex_);
-        order_status_cache_[order->order_id] = *order;
-        
-        // SEC Compliance: Notify about order status change for persistence
-        if (order_status_callback_) {
-            std::lock_guard<std::mutex> cb_lock(order_status_callback_mutex_);
-            if (order_status_callback_) {
-                order_status_callback_(*order);
+        publishOrderStatus(*order);
+
+        // SEC Compliance: route the status change through the trade queue so
+        // persistence runs on the publisher thread, not inside matching
+        if (has_order_status_callback_.load(std::memory_order_acquire)) {
+            TradeMessage* status_msg = trade_message_pool_.allocate(*order);
+            while (!trade_queue_.enqueue(status_msg)) {
+                if (!running_.load(std::memory_order_acquire)) {
+                    trade_message_pool_.deallocate(status_msg);
+                    return;
+                }
+                std::this_thread::yield();
             }
+            trade_wake_target_->notifyWork();
         }
     }
-    
+
     // Send trades to publisher
     for (const auto& trade : trades) {
         TradeMessage* trade_msg = trade_message_pool_.allocate(trade, true);
@@ -605,7 +839,8 @@ void Stock::processNewOrder(const Order& incoming_order) {
             }
             std::this_thread::yield();
         }
-        
+        trade_wake_target_->notifyWork();
+
         // Update market data
         last_price_.store(trade.price, std::memory_order_relaxed);
         volume_.fetch_add(trade.quantity, std::memory_order_relaxed);
@@ -626,14 +861,12 @@ void Stock::processCancelOrder(const std::string& order_id) {
         {
             std::unique_lock<std::shared_mutex> book_lock(orderbook_mutex_);
             removeOrderFromBook(order);
+            publishDepthSnapshot();
         }
         order->status = "cancelled";
-        
-        // Update order status cache
-        {
-            std::lock_guard<std::mutex> lock(order_status_mutex_);
-            order_status_cache_[order_id] = *order;
-        }
+
+        // Publish cancelled status
+        publishOrderStatus(*order);
         
         if (release_callback_) {
             release_callback_(*order, "cancelled");
@@ -644,6 +877,42 @@ void Stock::processCancelOrder(const std::string& order_id) {
     }
 }
 
+void Stock::processCancelAllForUser(UserHandle user_handle) {
+    auto head_it = user_order_heads_.find(user_handle);
+    if (head_it == user_order_heads_.end()) {
+        return; // No resting orders for this user
+    }
+
+    // Unlink the user's orders under one book lock and one depth publish;
+    // status/release/deallocate follow outside the lock, mirroring
+    // processCancelOrder. removeOrderFromBook erases the head entry when the
+    // last order unlinks, so walk via saved next pointers, not the iterator.
+    std::vector<Order*> cancelled;
+    {
+        std::unique_lock<std::shared_mutex> book_lock(orderbook_mutex_);
+        Order* order = head_it->second;
+        while (order) {
+            Order* next = order->next_for_user;
+            removeOrderFromBook(order);
+            cancelled.push_back(order);
+            order = next;
+        }
+        publishDepthSnapshot();
+    }
+
+    for (Order* order : cancelled) {
+        order->status = "cancelled";
+        publishOrderStatus(*order);
+
+        if (release_callback_) {
+            release_callback_(*order, "cancelled");
+        }
+
+        orders_.erase(order->order_id);
+        order_pool_.deallocate(order);
+    }
+}
+
 std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
     std::vector<Trade> trades;
     
@@ -664,7 +933,7 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 // Count only non-self orders
                 Order* maker = level->first_order;
                 while (maker) {
-                    if (maker->user_id != incoming_order->user_id) {
+                    if (maker->user_handle != incoming_order->user_handle) {
                         available_qty += maker->remaining_qty;
                     }
                     maker = maker->next_at_price;
@@ -681,7 +950,7 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 // Count only non-self orders
                 Order* maker = level->first_order;
                 while (maker) {
-                    if (maker->user_id != incoming_order->user_id) {
+                    if (maker->user_handle != incoming_order->user_handle) {
                         available_qty += maker->remaining_qty;
                     }
                     maker = maker->next_at_price;
@@ -725,13 +994,14 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
             if (!sell_order || sell_order->remaining_qty == 0) {
                 // Remove empty level
                 best_ask_ = ask_level->next_level;
+                ask_ladder_.erase(ask_level);
                 price_level_pool_.deallocate(ask_level);
                 continue;
             }
             
             // Self-trade prevention: skip orders from same user
             // Keep searching through orders at this price level until we find one from a different user
-            while (sell_order && incoming_order->user_id == sell_order->user_id) {
+            while (sell_order && incoming_order->user_handle == sell_order->user_handle) {
                 sell_order = sell_order->next_at_price;
             }
             
@@ -751,23 +1021,22 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                     // Mark as cancelled and update cache
                     order_at_level->status = "cancelled";
                     order_at_level->remaining_qty = 0;
-                    {
-                        std::lock_guard<std::mutex> lock(order_status_mutex_);
-                        order_status_cache_[order_at_level->order_id] = *order_at_level;
-                    }
+                    publishOrderStatus(*order_at_level);
                     if (release_callback_) {
                         release_callback_(*order_at_level, "cancelled");
                     }
                     // Clean up
                     orders_.erase(order_at_level->order_id);
                     total_sell_orders_.fetch_sub(1, std::memory_order_relaxed);
+                    unlinkFromUserList(order_at_level);
                     order_at_level->price_level = nullptr;  // Prevent use-after-free
                     order_pool_.deallocate(order_at_level);
-                    
+
                     order_at_level = next_order;
                 }
-                
+
                 // Deallocate the empty level
+                ask_ladder_.erase(level_to_skip);
                 price_level_pool_.deallocate(level_to_skip);
                 continue;
             }
@@ -788,7 +1057,9 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 now,
                 incoming_order->user_id,
                 sell_order->user_id);
-            
+            trades.back().buy_user_handle = incoming_order->user_handle;
+            trades.back().sell_user_handle = sell_order->user_handle;
+
             // Update orders
             incoming_order->remaining_qty -= trade_qty;
             sell_order->remaining_qty -= trade_qty;
@@ -811,25 +1082,21 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 total_sell_orders_.fetch_sub(1, std::memory_order_relaxed);
                 
                 // Update order status cache before cleanup
-                {
-                    std::lock_guard<std::mutex> lock(order_status_mutex_);
-                    order_status_cache_[sell_order->order_id] = *sell_order;
-                }
+                publishOrderStatus(*sell_order);
                 if (release_callback_) {
                     release_callback_(*sell_order, sell_order->status);
                 }
                 
-                // Clean up filled order
+                // Clean up filled order: detach from the user list before the
+                // pool reuses the block
+                unlinkFromUserList(sell_order);
                 orders_.erase(sell_order->order_id);
                 order_pool_.deallocate(sell_order);
             } else {
                 sell_order->status = "partial";
                 
                 // Update order status cache for the matched order
-                {
-                    std::lock_guard<std::mutex> lock(order_status_mutex_);
-                    order_status_cache_[sell_order->order_id] = *sell_order;
-                }
+                publishOrderStatus(*sell_order);
             }
         }
     } else { // SELL order
@@ -859,13 +1126,14 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
             if (!buy_order || buy_order->remaining_qty == 0) {
                 // Remove empty level
                 best_bid_ = bid_level->next_level;
+                bid_ladder_.erase(bid_level);
                 price_level_pool_.deallocate(bid_level);
                 continue;
             }
             
             // Self-trade prevention: skip orders from same user
             // Keep searching through orders at this price level until we find one from a different user
-            while (buy_order && incoming_order->user_id == buy_order->user_id) {
+            while (buy_order && incoming_order->user_handle == buy_order->user_handle) {
                 buy_order = buy_order->next_at_price;
             }
             
@@ -885,10 +1153,7 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                     // Mark as cancelled and update cache
                     order_at_level->status = "cancelled";
                     order_at_level->remaining_qty = 0;
-                    {
-                        std::lock_guard<std::mutex> lock(order_status_mutex_);
-                        order_status_cache_[order_at_level->order_id] = *order_at_level;
-                    }
+                    publishOrderStatus(*order_at_level);
                     if (release_callback_) {
                         release_callback_(*order_at_level, "cancelled");
                     }
@@ -896,13 +1161,15 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                     // Clean up
                     orders_.erase(order_at_level->order_id);
                     total_buy_orders_.fetch_sub(1, std::memory_order_relaxed);
+                    unlinkFromUserList(order_at_level);
                     order_at_level->price_level = nullptr;  // Prevent use-after-free
                     order_pool_.deallocate(order_at_level);
-                    
+
                     order_at_level = next_order;
                 }
-                
+
                 // Deallocate the empty level
+                bid_ladder_.erase(level_to_skip);
                 price_level_pool_.deallocate(level_to_skip);
                 continue;
             }
@@ -923,7 +1190,9 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 now,
                 buy_order->user_id,
                 incoming_order->user_id);
-            
+            trades.back().buy_user_handle = buy_order->user_handle;
+            trades.back().sell_user_handle = incoming_order->user_handle;
+
             // Update orders
             incoming_order->remaining_qty -= trade_qty;
             buy_order->remaining_qty -= trade_qty;
@@ -946,25 +1215,21 @@ std::vector<Trade> Stock::matchOrder(Order* incoming_order) {
                 total_buy_orders_.fetch_sub(1, std::memory_order_relaxed);
                 
                 // Update order status cache before cleanup
-                {
-                    std::lock_guard<std::mutex> lock(order_status_mutex_);
-                    order_status_cache_[buy_order->order_id] = *buy_order;
-                }
+                publishOrderStatus(*buy_order);
                 if (release_callback_) {
                     release_callback_(*buy_order, buy_order->status);
                 }
                 
-                // Clean up filled order
+                // Clean up filled order: detach from the user list before the
+                // pool reuses the block
+                unlinkFromUserList(buy_order);
                 orders_.erase(buy_order->order_id);
                 order_pool_.deallocate(buy_order);
             } else {
                 buy_order->status = "partial";
                 
                 // Update order status cache for the matched order
-                {
-                    std::lock_guard<std::mutex> lock(order_status_mutex_);
-                    order_status_cache_[buy_order->order_id] = *buy_order;
-                }
+                publishOrderStatus(*buy_order);
             }
         }
     }
@@ -988,7 +1253,16 @@ void Stock::addOrderToBook(Order* order) {
     // No lock needed - only called from matching thread which has exclusive write access
     PriceLevelNode* level = findOrCreatePriceLevel(order->price, order->side == 0);
     level->addOrder(order);
-    
+
+    // Thread the order onto its user's intrusive open-order list
+    Order*& user_head = user_order_heads_[order->user_handle];
+    order->prev_for_user = nullptr;
+    order->next_for_user = user_head;
+    if (user_head) {
+        user_head->prev_for_user = order;
+    }
+    user_head = order;
+
     // Update order book depth counters
     if (order->side == 0) {
         total_buy_orders_.fetch_add(1, std::memory_order_relaxed);
@@ -997,11 +1271,103 @@ void Stock::addOrderToBook(Order* order) {
     }
 }
 
+std::vector<Order> Stock::collectOpenOrders() const {
+    std::vector<Order> open_orders;
+
+    // The level chains are only mutated under the unique book lock, so a
+    // shared lock gives a consistent walk while matching continues
+    std::shared_lock<std::shared_mutex> book_lock(orderbook_mutex_);
+
+    for (const PriceLevelNode* level = best_bid_; level; level = level->next_level) {
+        for (const Order* order = level->first_order; order; order = order->next_at_price) {
+            open_orders.push_back(*order);
+        }
+    }
+    for (const PriceLevelNode* level = best_ask_; level; level = level->next_level) {
+        for (const Order* order = level->first_order; order; order = order->next_at_price) {
+            open_orders.push_back(*order);
+        }
+    }
+
+    // The intrusive pointers are meaningless outside the book
+    for (auto& order : open_orders) {
+        order.next_at_price = nullptr;
+        order.prev_at_price = nullptr;
+        order.price_level = nullptr;
+        order.next_for_user = nullptr;
+        order.prev_for_user = nullptr;
+    }
+
+    return open_orders;
+}
+
+bool Stock::restoreOrder(const Order& incoming_order) {
+    if (incoming_order.remaining_qty <= 0) {
+        return false; // Filled or cancelled between capture and restart
+    }
+    if (orders_.find(incoming_order.order_id) != orders_.end()) {
+        return false; // Already restored (snapshot/journal overlap)
+    }
+
+    size_t side_depth = (incoming_order.side == 0)
+        ? total_buy_orders_.load(std::memory_order_relaxed)
+        : total_sell_orders_.load(std::memory_order_relaxed);
+    if (side_depth >= MAX_ORDER_BOOK_DEPTH) {
+        return false;
+    }
+
+    Order* order = order_pool_.allocate(incoming_order);
+    order->next_at_price = nullptr;
+    order->prev_at_price = nullptr;
+    order->price_level = nullptr;
+    order->next_for_user = nullptr;
+    order->prev_for_user = nullptr;
+
+    // Handles are process-local (see InternTable.h) and not stable across
+    // restarts, so re-intern rather than trusting snapshotted values
+    order->user_handle = static_cast<UserHandle>(InternTable::users().intern(order->user_id));
+    order->symbol_handle = static_cast<SymbolHandle>(InternTable::symbols().intern(symbol_));
+    if (order->order_seq == 0) {
+        order->order_seq = nextOrderSequence();
+    }
+
+    orders_[order->order_id] = order;
+    publishOrderStatus(*order);
+    {
+        std::unique_lock<std::shared_mutex> book_lock(orderbook_mutex_);
+        addOrderToBook(order);
+        publishDepthSnapshot();
+    }
+    return true;
+}
+
+void Stock::unlinkFromUserList(Order* order) {
+    if (order->prev_for_user) {
+        order->prev_for_user->next_for_user = order->next_for_user;
+    } else {
+        auto user_it = user_order_heads_.find(order->user_handle);
+        if (user_it != user_order_heads_.end()) {
+            user_it->second = order->next_for_user;
+            if (user_it->second == nullptr) {
+                user_order_heads_.erase(user_it);
+            }
+        }
+    }
+    if (order->next_for_user) {
+        order->next_for_user->prev_for_user = order->prev_for_user;
+    }
+    order->next_for_user = nullptr;
+    order->prev_for_user = nullptr;
+}
+
 void Stock::removeOrderFromBook(Order* order) {
     if (!order || !order->price_level) {
         return; // Order not in book
     }
-    
+
+    // Unlink from the user's intrusive open-order list
+    unlinkFromUserList(order);
+
     // Update order book depth counters
     if (order->side == 0) {
         total_buy_orders_.fetch_sub(1, std::memory_order_relaxed);
@@ -1015,40 +1381,31 @@ void Stock::removeOrderFromBook(Order* order) {
     // Remove order from the price level's linked list
     level->removeOrder(order);
     
-    // If the price level is now empty, remove it from the book
+    // If the price level is now empty, remove it from the book. The ladder
+    // index resolves the chain predecessor without walking the level list.
     if (level->total_quantity == 0 && level->first_order == nullptr) {
         if (order->side == 0) { // BUY side
-            // Remove from bid side
             if (best_bid_ == level) {
                 best_bid_ = level->next_level;
-                price_level_pool_.deallocate(level);
             } else {
-                // Find and remove from middle of list
-                PriceLevelNode* current = best_bid_;
-                while (current && current->next_level != level) {
-                    current = current->next_level;
-                }
-                if (current) {
-                    current->next_level = level->next_level;
-                    price_level_pool_.deallocate(level);
+                PriceLevelNode* pred = bid_ladder_.levelAbove(level->price);
+                if (pred) {
+                    pred->next_level = level->next_level;
                 }
             }
+            bid_ladder_.erase(level);
+            price_level_pool_.deallocate(level);
         } else { // SELL side
-            // Remove from ask side
             if (best_ask_ == level) {
                 best_ask_ = level->next_level;
-                price_level_pool_.deallocate(level);
             } else {
-                // Find and remove from middle of list
-                PriceLevelNode* current = best_ask_;
-                while (current && current->next_level != level) {
-                    current = current->next_level;
-                }
-                if (current) {
-                    current->next_level = level->next_level;
-                    price_level_pool_.deallocate(level);
+                PriceLevelNode* pred = ask_ladder_.levelBelow(level->price);
+                if (pred) {
+                    pred->next_level = level->next_level;
                 }
             }
+            ask_ladder_.erase(level);
+            price_level_pool_.deallocate(level);
         }
     }
     
@@ -1056,53 +1413,41 @@ void Stock::removeOrderFromBook(Order* order) {
 }
 
 PriceLevelNode* Stock::findOrCreatePriceLevel(Price price, bool is_buy) {
+    // Ladder-indexed lookup: O(1) array hit for near-touch prices, sorted
+    // index for the rest. Replaces the O(levels) walk of the next_level chain.
+    PriceLadder& ladder = is_buy ? bid_ladder_ : ask_ladder_;
+    if (PriceLevelNode* existing = ladder.find(price)) {
+        return existing;
+    }
+
+    PriceLevelNode* new_level = price_level_pool_.allocate(price);
+
     if (is_buy) {
-        // Find insertion point in bid side (descending order)
-        if (!best_bid_ || price > best_bid_->price) {
-            PriceLevelNode* new_level = price_level_pool_.allocate(price);
+        // Bid chain is descending: the chain predecessor is the lowest live
+        // level strictly above this price
+        PriceLevelNode* pred = ladder.levelAbove(price);
+        if (!pred) {
             new_level->next_level = best_bid_;
             best_bid_ = new_level;
-            return new_level;
-        }
-        
-        PriceLevelNode* current = best_bid_;
-        while (current) {
-            if (current->price == price) {
-                return current;
-            }
-            if (current->next_level == nullptr || current->next_level->price < price) {
-                PriceLevelNode* new_level = price_level_pool_.allocate(price);
-                new_level->next_level = current->next_level;
-                current->next_level = new_level;
-                return new_level;
-            }
-            current = current->next_level;
+        } else {
+            new_level->next_level = pred->next_level;
+            pred->next_level = new_level;
         }
     } else {
-        // Find insertion point in ask side (ascending order)
-        if (!best_ask_ || price < best_ask_->price) {
-            PriceLevelNode* new_level = price_level_pool_.allocate(price);
+        // Ask chain is ascending: the chain predecessor is the highest live
+        // level strictly below this price
+        PriceLevelNode* pred = ladder.levelBelow(price);
+        if (!pred) {
             new_level->next_level = best_ask_;
             best_ask_ = new_level;
-            return new_level;
-        }
-        
-        PriceLevelNode* current = best_ask_;
-        while (current) {
-            if (current->price == price) {
-                return current;
-            }
-            if (current->next_level == nullptr || current->next_level->price > price) {
-                PriceLevelNode* new_level = price_level_pool_.allocate(price);
-                new_level->next_level = current->next_level;
-                current->next_level = new_level;
-                return new_level;
-            }
-            current = current->next_level;
+        } else {
+            new_level->next_level = pred->next_level;
+            pred->next_level = new_level;
         }
     }
-    
-    return nullptr; // Should never reach here
+
+    ladder.insert(new_level);
+    return new_level;
 }
 
 void Stock::updateDailyStats(Price price, int64_t quantity) {
@@ -1121,33 +1466,29 @@ void Stock::updateDailyStats(Price price, int64_t quantity) {
         current_low = day_low_.load(std::memory_order_relaxed);
     }
     
-    // Update VWAP (Volume Weighted Average Price) with proper synchronization
-    {
-        std::lock_guard<std::mutex> lock(vwap_mutex_);
-        double price_double = static_cast<double>(price) / 100.0;
-        double trade_value = price_double * quantity;
-        
-        // CRITICAL: Prevent overflow after many trades
-        // If denominator gets too large, reset with current weighted average
-        static constexpr int64_t VWAP_RESET_THRESHOLD = INT64_MAX / 2;
-        if (vwap_denominator_ > VWAP_RESET_THRESHOLD) {
-            // Reset VWAP accumulators while preserving the current VWAP value
-            double current_vwap = vwap_.load(std::memory_order_relaxed);
-            vwap_numerator_ = current_vwap * 1000000; // Scale to reasonable precision
-            vwap_denominator_ = 1000000;
-        }
-        
-        vwap_numerator_ += trade_value;
-        vwap_denominator_ += quantity;
-        
-        if (vwap_denominator_ > 0) {
-            double new_vwap = vwap_numerator_ / vwap_denominator_;
-            vwap_.store(new_vwap, std::memory_order_relaxed);
-        }
-        
-        // Also update total value traded for other stats
-        total_value_traded_.fetch_add(trade_value, std::memory_order_relaxed);
+    // Update VWAP accumulators (matching thread only, fixed-point all the
+    // way: price is already cents, so value_sum is cents*shares)
+
+    // CRITICAL: Prevent overflow after many trades. Rescale while preserving
+    // the current weighted average before either sum can wrap.
+    static constexpr int64_t VWAP_RESET_THRESHOLD = INT64_MAX / 2;
+    if (vwap_value_sum_ > VWAP_RESET_THRESHOLD || vwap_volume_sum_ > VWAP_RESET_THRESHOLD) {
+        int64_t current_vwap = vwap_value_sum_ / vwap_volume_sum_;
+        vwap_value_sum_ = current_vwap * 1000000; // Scale to reasonable precision
+        vwap_volume_sum_ = 1000000;
     }
+
+    vwap_value_sum_ += price * quantity;
+    vwap_volume_sum_ += quantity;
+
+    // Seqlock publish (single writer): odd version marks the write in flight
+    uint64_t version = vwap_snapshot_.version.load(std::memory_order_relaxed);
+    vwap_snapshot_.version.store(version + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    vwap_snapshot_.value_sum = vwap_value_sum_;
+    vwap_snapshot_.volume_sum = vwap_volume_sum_;
+    std::atomic_thread_fence(std::memory_order_release);
+    vwap_snapshot_.version.store(version + 2, std::memory_order_release);
 }
 
 void Stock::updateMarketData() {
@@ -1189,6 +1530,7 @@ void Stock::updateMarketData() {
         }
         std::this_thread::yield();
     }
+    market_data_wake_target_->notifyWork();
 }
 double Stock::getChangePercent() const {
     Price open = open_price_.load(std::memory_order_relaxed);
@@ -1209,83 +1551,139 @@ Price Stock::getChangePointsFixed() const {
     return current - open;
 }
 
-std::vector<PriceLevel> Stock::getTopBids(int count) const {
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+void Stock::publishDepthSnapshot() {
+    // Single writer (matching thread, under the book lock). An odd version
+    // tells readers a write is in flight.
+    uint64_t version = depth_snapshot_.version.load(std::memory_order_relaxed);
+    depth_snapshot_.version.store(version + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
 
-    {
-        std::lock_guard<std::mutex> cache_lock(snapshot_mutex_);
-        int64_t last_snapshot = last_bids_snapshot_time_ms_.load(std::memory_order_relaxed);
-        if (now - last_snapshot < SNAPSHOT_CACHE_MS && !cached_bids_.empty()) {
-            int items = (std::min)(count, static_cast<int>(cached_bids_.size()));
-            return std::vector<PriceLevel>(cached_bids_.begin(), cached_bids_.begin() + items);
+    int added = 0;
+    PriceLevelNode* level = best_bid_;
+    while (level && added < DepthSnapshot::MAX_DEPTH) {
+        if (level->total_quantity > 0) {
+            depth_snapshot_.bids[added] = PriceLevel(level->price, level->total_quantity);
+            added++;
         }
+        level = level->next_level;
     }
+    depth_snapshot_.bid_count = added;
 
-    std::vector<PriceLevel> bids;
-    {
-        std::shared_lock<std::shared_mutex> lock(orderbook_mutex_);
+    added = 0;
+    level = best_ask_;
+    while (level && added < DepthSnapshot::MAX_DEPTH) {
+        if (level->total_quantity > 0) {
+            depth_snapshot_.asks[added] = PriceLevel(level->price, level->total_quantity);
+            added++;
+        }
+        level = level->next_level;
+    }
+    depth_snapshot_.ask_count = added;
 
-        PriceLevelNode* level = best_bid_;
-        int added = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    depth_snapshot_.version.store(version + 2, std::memory_order_release);
+}
 
-        while (level && added < count) {
-            if (level->total_quantity > 0) {
-                bids.emplace_back(level->price, level->total_quantity);
-                added++;
+std::vector<PriceLevel> Stock::readDepthSnapshot(int count, bool bids) const {
+    PriceLevel levels[DepthSnapshot::MAX_DEPTH];
+    int available = 0;
+
+    // Wait-free seqlock read: retry on a torn copy (version changed or odd)
+    for (;;) {
+        uint64_t v1 = depth_snapshot_.version.load(std::memory_order_acquire);
+        if (v1 & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (bids) {
+            available = depth_snapshot_.bid_count;
+            for (int i = 0; i < DepthSnapshot::MAX_DEPTH; ++i) {
+                levels[i] = depth_snapshot_.bids[i];
             }
-            level = level->next_level;
+        } else {
+            available = depth_snapshot_.ask_count;
+            for (int i = 0; i < DepthSnapshot::MAX_DEPTH; ++i) {
+                levels[i] = depth_snapshot_.asks[i];
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (depth_snapshot_.version.load(std::memory_order_relaxed) == v1) {
+            break;
         }
     }
 
-    {
-        std::lock_guard<std::mutex> cache_lock(snapshot_mutex_);
-        cached_bids_ = bids;
-        last_bids_snapshot_time_ms_.store(now, std::memory_order_relaxed);
-        int items = (std::min)(count, static_cast<int>(cached_bids_.size()));
-        return std::vector<PriceLevel>(cached_bids_.begin(), cached_bids_.begin() + items);
+    int items = (std::min)(count, available);
+    return std::vector<PriceLevel>(levels, levels + items);
+}
+
+std::vector<PriceLevel> Stock::getTopBids(int count) const {
+    if (count <= DepthSnapshot::MAX_DEPTH) {
+        return readDepthSnapshot(count, true);
+    }
+
+    // Deeper-than-snapshot requests fall back to walking the book
+    std::vector<PriceLevel> bids;
+    std::shared_lock<std::shared_mutex> lock(orderbook_mutex_);
+
+    PriceLevelNode* level = best_bid_;
+    int added = 0;
+    while (level && added < count) {
+        if (level->total_quantity > 0) {
+            bids.emplace_back(level->price, level->total_quantity);
+            added++;
+        }
+        level = level->next_level;
     }
+    return bids;
 }
 
 std::vector<PriceLevel> Stock::getTopAsks(int count) const {
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (count <= DepthSnapshot::MAX_DEPTH) {
+        return readDepthSnapshot(count, false);
+    }
 
-    {
-        std::lock_guard<std::mutex> cache_lock(snapshot_mutex_);
-        int64_t last_snapshot = last_asks_snapshot_time_ms_.load(std::memory_order_relaxed);
-        if (now - last_snapshot < SNAPSHOT_CACHE_MS && !cached_asks_.empty()) {
-            int items = (std::min)(count, static_cast<int>(cached_asks_.size()));
-            return std::vector<PriceLevel>(cached_asks_.begin(), cached_asks_.begin() + items);
+    // Deeper-than-snapshot requests fall back to walking the book
+    std::vector<PriceLevel> asks;
+    std::shared_lock<std::shared_mutex> lock(orderbook_mutex_);
+
+    PriceLevelNode* level = best_ask_;
+    int added = 0;
+    while (level && added < count) {
+        if (level->total_quantity > 0) {
+            asks.emplace_back(level->price, level->total_quantity);
+            added++;
         }
+        level = level->next_level;
     }
+    return asks;
+}
 
-    std::vector<PriceLevel> asks;
-    {
-        std::shared_lock<std::shared_mutex> lock(orderbook_mutex_);
+Price Stock::getVWAPFixed() const {
+    int64_t value_sum = 0;
+    int64_t volume_sum = 0;
+
+    // Wait-free seqlock read: retry on a torn copy (version changed or odd)
+    for (;;) {
+        uint64_t v1 = vwap_snapshot_.version.load(std::memory_order_acquire);
+        if (v1 & 1) {
+            std::this_thread::yield();
+            continue;
+        }
 
-        PriceLevelNode* level = best_ask_;
-        int added = 0;
+        value_sum = vwap_snapshot_.value_sum;
+        volume_sum = vwap_snapshot_.volume_sum;
 
-        while (level && added < count) {
-            if (level->total_quantity > 0) {
-                asks.emplace_back(level->price, level->total_quantity);
-                added++;
-            }
-            level = level->next_level;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (vwap_snapshot_.version.load(std::memory_order_relaxed) == v1) {
+            break;
         }
     }
 
-    {
-        std::lock_guard<std::mutex> cache_lock(snapshot_mutex_);
-        cached_asks_ = asks;
-        last_asks_snapshot_time_ms_.store(now, std::memory_order_relaxed);
-        int items = (std::min)(count, static_cast<int>(cached_asks_.size()));
-        return std::vector<PriceLevel>(cached_asks_.begin(), cached_asks_.begin() + items);
+    // No trades yet: report the last (initial) price as the VWAP
+    if (volume_sum == 0) {
+        return last_price_.load(std::memory_order_relaxed);
     }
-}
-
-Price Stock::getVWAPFixed() const {
-    const double vwap_value = vwap_.load(std::memory_order_relaxed);
-    return static_cast<Price>(std::llround(vwap_value * 100.0));
+    return static_cast<Price>(value_sum / volume_sum);
 }
@@ -21,12 +21,24 @@
 #include "MemoryPool.h"
 #include "CPUAffinity.h"
 #include "AdaptiveLoadManager.h"
+#include "DailyStatsBoard.h"
+#include "OrderStatusStore.h"
+#include "../common/InternTable.h"
+#include <absl/container/flat_hash_map.h>
 
 // Fixed-point arithmetic: prices stored as 1/100th of currency unit
 // $123.45 becomes 12345 (integer)
 using Price = int64_t;
 using CashAmount = int64_t;
 
+// Threading model for a Stock instance:
+// - DEDICATED: the stock owns three pinned worker threads (matching, market
+//   data, trade publisher). Good for a handful of hot symbols.
+// - SHARDED: the stock owns no threads; a shard worker in StockExchange
+//   drives its queues via the pump*() methods. Keeps the engine thread count
+//   constant as the symbol list grows.
+enum class StockThreadingMode { DEDICATED, SHARDED };
+
 // Forward declaration
 struct PriceLevelNode;
 
@@ -45,6 +57,17 @@ struct Order {
     std::string order_id;
     std::string user_id;
     std::string symbol;
+    // Interned handles, resolved once at the API edge (see InternTable.h).
+    // The strings above stay authoritative for persistence and wire replies;
+    // the matching path compares these integers instead. 0 = unresolved,
+    // backfilled in Stock::submitOrder.
+    SymbolHandle symbol_handle = INVALID_SYMBOL_HANDLE;
+    UserHandle user_handle = INVALID_USER_HANDLE;
+    uint64_t order_seq = 0; // Numeric order identity from nextOrderSequence()
+    // TSC stamp taken at API ingress for latency-sampled orders (0 =
+    // unsampled); the matching thread turns it into per-stage percentiles
+    // via EngineTelemetry
+    uint64_t ingress_tsc = 0;
     int side;  // 0=BUY, 1=SELL
     int type;  // 0=MARKET, 1=LIMIT, 2=IOC, 3=FOK
     int64_t quantity;
@@ -55,12 +78,17 @@ struct Order {
     Order* next_at_price; // For linking orders at same price level
     Order* prev_at_price; // For O(1) removal from price level
     PriceLevelNode* price_level; // Track which level this order is in
-    
+    // Intrusive per-user list threaded through the user's resting orders
+    // (head in Stock::user_order_heads_), so a mass cancel walks exactly
+    // this user's k orders instead of scanning the whole order index
+    Order* next_for_user = nullptr;
+    Order* prev_for_user = nullptr;
+
     Order() = default;
-    Order(const std::string& id, const std::string& uid, const std::string& sym, 
+    Order(const std::string& id, const std::string& uid, const std::string& sym,
           int s, int t, int64_t qty, Price p, int64_t ts)
-        : order_id(id), user_id(uid), symbol(sym), side(s), type(t), 
-          quantity(qty), remaining_qty(qty), price(p), timestamp_ms(ts), 
+        : order_id(id), user_id(uid), symbol(sym), side(s), type(t),
+          quantity(qty), remaining_qty(qty), price(p), timestamp_ms(ts),
           status("open"), next_at_price(nullptr), prev_at_price(nullptr), price_level(nullptr) {}
 
     // Helper functions for conversion
@@ -81,7 +109,11 @@ struct Trade {
     int64_t timestamp_ms;
         std::string buy_user_id;
         std::string sell_user_id;
-    
+    // Interned counterparties (see InternTable.h); settlement consumers can
+    // compare/group by these without touching the strings
+    UserHandle buy_user_handle = INVALID_USER_HANDLE;
+    UserHandle sell_user_handle = INVALID_USER_HANDLE;
+
     Trade() = default;
     Trade(const std::string& buy_id, const std::string& sell_id, const std::string& sym, 
                     Price p, int64_t qty, int64_t ts, std::string buy_uid, std::string sell_uid)
@@ -102,22 +134,35 @@ using OrderStatusCallback = std::function<void(const Order&)>;
 
 // Messages for lock-free communication
 struct OrderMessage {
-    enum Type { NEW_ORDER, CANCEL_ORDER, MARKET_DATA_REQUEST };
+    enum Type { NEW_ORDER, CANCEL_ORDER, MARKET_DATA_REQUEST, CANCEL_ALL_FOR_USER };
     Type type;
     Order order;
     std::string cancel_order_id;
-    
+    // Target of a CANCEL_ALL_FOR_USER (risk pull); resolved at the API edge
+    UserHandle cancel_user_handle = INVALID_USER_HANDLE;
+
     OrderMessage() = default;
     OrderMessage(Type t, const Order& o) : type(t), order(o) {}
     OrderMessage(Type t, const std::string& cancel_id) : type(t), cancel_order_id(cancel_id) {}
+    OrderMessage(Type t, UserHandle user_handle) : type(t), cancel_user_handle(user_handle) {}
 };
 
+// Messages on the trade publisher queue. Besides executed trades it carries
+// order status updates, so settlement, status persistence and subscriber
+// callbacks all run on the publisher thread in drained batches and the
+// matching thread never invokes a user callback.
 struct TradeMessage {
+    enum Kind { TRADE, ORDER_STATUS };
+
+    Kind kind;
     Trade trade;
+    Order order_status;  // Valid when kind == ORDER_STATUS
     bool ack_required;
-    
-    TradeMessage() : ack_required(false) {}
-    TradeMessage(const Trade& t, bool ack = false) : trade(t), ack_required(ack) {}
+
+    TradeMessage() : kind(TRADE), ack_required(false) {}
+    TradeMessage(const Trade& t, bool ack = false) : kind(TRADE), trade(t), ack_required(ack) {}
+    explicit TradeMessage(const Order& order)
+        : kind(ORDER_STATUS), order_status(order), ack_required(false) {}
 };
 
 struct MarketDataMessage {
@@ -180,21 +225,94 @@ struct PriceLevelNode {
     }
 };
 
+// Per-side price ladder index (single writer: the matching thread). The
+// sorted next_level chain on PriceLevelNode stays canonical for matching and
+// snapshots; this structure only accelerates level lookup and chain-neighbour
+// resolution. A contiguous window of one-cent slots anchored around the first
+// observed price gives O(1) array lookup for near-touch levels (the common
+// case), and a sorted index over all live levels answers far-away prices and
+// insertion points without pointer-chasing the chain.
+struct PriceLadder {
+    static constexpr size_t WINDOW_TICKS = 4096; // ~$40.96 around the anchor
+
+    std::vector<PriceLevelNode*> window;
+    Price window_base = 0; // Price of window[0]; 0 = not anchored yet
+    std::map<Price, PriceLevelNode*> level_index; // All live levels, ascending
+
+    PriceLevelNode* find(Price price) const {
+        if (window_base != 0) {
+            int64_t idx = price - window_base;
+            if (idx >= 0 && idx < static_cast<int64_t>(window.size())) {
+                return window[idx];
+            }
+        }
+        auto it = level_index.find(price);
+        return (it != level_index.end()) ? it->second : nullptr;
+    }
+
+    void insert(PriceLevelNode* level) {
+        if (window_base == 0) {
+            // Anchor the dense window around the first level; prices that
+            // later drift outside it are served by level_index alone
+            window.assign(WINDOW_TICKS, nullptr);
+            const Price half = static_cast<Price>(WINDOW_TICKS / 2);
+            window_base = (level->price > half) ? level->price - half : 1;
+        }
+        int64_t idx = level->price - window_base;
+        if (idx >= 0 && idx < static_cast<int64_t>(window.size())) {
+            window[idx] = level;
+        }
+        level_index.emplace(level->price, level);
+    }
+
+    void erase(PriceLevelNode* level) {
+        if (window_base != 0) {
+            int64_t idx = level->price - window_base;
+            if (idx >= 0 && idx < static_cast<int64_t>(window.size())) {
+                window[idx] = nullptr;
+            }
+        }
+        level_index.erase(level->price);
+    }
+
+    // Lowest live level strictly above `price` (chain predecessor on the
+    // descending bid side)
+    PriceLevelNode* levelAbove(Price price) const {
+        auto it = level_index.upper_bound(price);
+        return (it != level_index.end()) ? it->second : nullptr;
+    }
+
+    // Highest live level strictly below `price` (chain predecessor on the
+    // ascending ask side)
+    PriceLevelNode* levelBelow(Price price) const {
+        auto it = level_index.lower_bound(price);
+        if (it == level_index.begin()) {
+            return nullptr;
+        }
+        return std::prev(it)->second;
+    }
+};
+
 class Stock {
 private:
     // Core data
     std::string symbol_;
-    std::atomic<Price> last_price_;
-    std::atomic<int64_t> volume_;
-    std::atomic<Price> open_price_;
-    std::atomic<Price> day_high_;
-    std::atomic<Price> day_low_;
-    std::atomic<double> vwap_;
-    std::atomic<double> total_value_traded_;
+    // Daily stats live in the process-wide SoA block (DailyStatsBoard.h),
+    // indexed by this stock's interned symbol handle. The references keep
+    // the matching path identical while the all-stocks snapshot builder
+    // sweeps the arrays linearly instead of visiting every Stock.
+    const size_t stats_slot_;
+    std::atomic<Price>& last_price_;
+    std::atomic<int64_t>& volume_;
+    std::atomic<Price>& open_price_;
+    std::atomic<Price>& day_high_;
+    std::atomic<Price>& day_low_;
     std::atomic<bool> running_;
+    StockThreadingMode threading_mode_;
     
     // Lock-free queues for communication
     static constexpr size_t QUEUE_SIZE = 4096; // Must be power of 2
+    static constexpr size_t QUEUE_BATCH_SIZE = 64; // Max messages per bulk dequeue
     MPSCQueue<OrderMessage, QUEUE_SIZE> order_queue_;           // Ingress -> Matching Engine
     SPSCQueue<TradeMessage, QUEUE_SIZE> trade_queue_;           // Matching Engine -> Trade Publisher  
     SPSCQueue<MarketDataMessage, QUEUE_SIZE> market_data_queue_; // Matching Engine -> Market Data Publisher
@@ -207,24 +325,44 @@ private:
     MemoryPool<MarketDataMessage, 512> market_data_message_pool_;
     
     // Fast order book (no locks in matching thread)
-    std::map<std::string, Order*> orders_; // Only accessed by matching thread
+    // Open-addressing index for cancel/lookup by order ID. Flat hashing avoids
+    // the per-node allocations and string-compare tree walks of std::map on
+    // cancel-heavy flow. Only accessed by matching thread.
+    absl::flat_hash_map<std::string, Order*> orders_;
+    // Head of each user's intrusive open-order list (links live in Order).
+    // Maintained by addOrderToBook/removeOrderFromBook on the matching
+    // thread; entries are erased when the last order unlinks.
+    absl::flat_hash_map<UserHandle, Order*> user_order_heads_;
     PriceLevelNode* best_bid_;
     PriceLevelNode* best_ask_;
+    PriceLadder bid_ladder_;  // Only accessed by matching thread
+    PriceLadder ask_ladder_;  // Only accessed by matching thread
     
-    // Thread-safe order status cache (for getOrderStatus queries)
-    mutable std::mutex order_status_mutex_;
-    mutable std::map<std::string, Order> order_status_cache_;
+    // Sharded order status store (see OrderStatusStore.h): ingress admits a
+    // PENDING record per order, the matching thread publishes every state
+    // change through a per-record seqlock, and getOrderStatus pollers copy
+    // the fixed-size record without blocking matching.
+    mutable OrderStatusStore order_status_store_;
     
     // Shared mutex for safe concurrent reading of order book (readers don't block readers)
     mutable std::shared_mutex orderbook_mutex_;
-    
-    // Cached snapshot for high-frequency reads (reduces lock contention)
-    mutable std::vector<PriceLevel> cached_bids_;
-    mutable std::vector<PriceLevel> cached_asks_;
-    mutable std::atomic<int64_t> last_bids_snapshot_time_ms_;
-    mutable std::atomic<int64_t> last_asks_snapshot_time_ms_;
-    mutable std::mutex snapshot_mutex_;
-    static constexpr int64_t SNAPSHOT_CACHE_MS = 100; // Cache for 100ms
+
+    // Seqlock-published top-of-book snapshot. The matching thread republishes
+    // after each book mutation (version is odd while a write is in flight);
+    // readers copy the fixed arrays wait-free and retry on a torn read, so
+    // concurrent streamers never contend on a mutex and depth is as fresh as
+    // the last mutation instead of a 100ms cache.
+    struct DepthSnapshot {
+        static constexpr int MAX_DEPTH = 10;
+        std::atomic<uint64_t> version{0};
+        PriceLevel bids[MAX_DEPTH];
+        PriceLevel asks[MAX_DEPTH];
+        int bid_count{0};
+        int ask_count{0};
+    };
+    mutable DepthSnapshot depth_snapshot_;
+    void publishDepthSnapshot(); // Matching thread only, under the book lock
+    std::vector<PriceLevel> readDepthSnapshot(int count, bool bids) const;
     
     // Worker threads
     std::thread matching_thread_;
@@ -244,10 +382,19 @@ private:
     std::atomic<size_t> total_buy_orders_{0};
     std::atomic<size_t> total_sell_orders_{0};
     
-    // VWAP calculation synchronization
-    mutable std::mutex vwap_mutex_;
-    double vwap_numerator_ = 0.0;  // Sum of (price * quantity)
-    int64_t vwap_denominator_ = 0;  // Sum of quantity
+    // VWAP accumulators, fixed-point and owned exclusively by the matching
+    // thread: value_sum is cents*shares, volume_sum is shares. Published
+    // through the same seqlock idiom as DepthSnapshot, so the fill path does
+    // plain integer adds plus two version stores and readers are wait-free —
+    // no mutex and no floating point anywhere near matching.
+    int64_t vwap_value_sum_ = 0;
+    int64_t vwap_volume_sum_ = 0;
+    struct VwapSnapshot {
+        std::atomic<uint64_t> version{0};
+        int64_t value_sum{0};
+        int64_t volume_sum{0};
+    };
+    mutable VwapSnapshot vwap_snapshot_;
     
     // Statistics for monitoring
     std::atomic<uint64_t> orders_processed_;
@@ -262,13 +409,25 @@ private:
     AdaptiveLoadManager market_data_load_manager_;
     AdaptiveLoadManager trade_publisher_load_manager_;
 
+    // Wake targets for event-driven idle: producers notify the load manager
+    // whose consumer drains the queue they just published to. In DEDICATED
+    // mode that is this stock's own managers; in SHARDED mode the exchange
+    // repoints all three at the owning shard worker's manager.
+    AdaptiveLoadManager* matching_wake_target_{&matching_load_manager_};
+    AdaptiveLoadManager* market_data_wake_target_{&market_data_load_manager_};
+    AdaptiveLoadManager* trade_wake_target_{&trade_publisher_load_manager_};
+
     // Optional trade observer for account settlement and analytics
     TradeCallback trade_callback_;
     mutable std::mutex trade_callback_mutex_;
     
-    // SEC Compliance: Order status observer for database persistence
+    // SEC Compliance: Order status observer for database persistence.
+    // has_order_status_callback_ lets the matching thread skip enqueueing
+    // status records entirely when nobody is listening, without touching
+    // the callback mutex.
     OrderStatusCallback order_status_callback_;
     mutable std::mutex order_status_callback_mutex_;
+    std::atomic<bool> has_order_status_callback_{false};
     
     OrderReserveCallback reserve_callback_;
     OrderReleaseCallback release_callback_;
@@ -277,9 +436,14 @@ private:
     void matchingEngineWorker();
     void marketDataWorker();
     void tradePublisherWorker();
-    
+
+    // Shared drain helper used by both threading modes on shutdown
+    void drainOrderQueueOnShutdown();
+
     void processNewOrder(const Order& order);
     void processCancelOrder(const std::string& order_id);
+    void processCancelAllForUser(UserHandle user_handle);
+    void publishOrderStatus(const Order& order);
     std::vector<Trade> matchOrder(Order* incoming_order);
     void updateMarketData();
     void updateDailyStats(Price price, int64_t quantity);
@@ -287,24 +451,68 @@ private:
     // Order book management (lockless, single thread)
     void addOrderToBook(Order* order);
     void removeOrderFromBook(Order* order);
+    // Detach an order from its user's intrusive open-order list. Must run
+    // before every order_pool_ deallocation (cancels, fills, self-trade
+    // skips) or the list threads through freed memory.
+    void unlinkFromUserList(Order* order);
     PriceLevelNode* findOrCreatePriceLevel(Price price, bool is_buy);
     
 public:
-    explicit Stock(const std::string& symbol, double initial_price = 100.0, 
-                   int matching_core = 1, int md_core = 2, int trade_core = 3);
+    explicit Stock(const std::string& symbol, double initial_price = 100.0,
+                   int matching_core = 1, int md_core = 2, int trade_core = 3,
+                   StockThreadingMode threading_mode = StockThreadingMode::DEDICATED);
     ~Stock();
-    
+
     void start();
     void stop();
+    // Pre-size the order index for the expected open-order count so the hash
+    // table never rehashes mid-session. Call before start().
+    void reserveOrderCapacity(size_t expected_orders);
+    // Fault in the memory pool arenas so the first orders of the session
+    // don't pay page faults. Called from the initializing thread, before
+    // start().
+    void prewarmPools();
+    // Book snapshot support (see BookSnapshot.h / StockExchange). Copies every
+    // resting order out of the book under the shared lock; safe to call from
+    // the snapshot thread while matching runs.
+    std::vector<Order> collectOpenOrders() const;
+    // Re-inserts a snapshotted order directly into the book without matching
+    // (it was already resting when captured). Call before start(), in original
+    // arrival order to preserve price-time priority. Returns false for
+    // duplicates, filled orders, or a full book side.
+    bool restoreOrder(const Order& order);
     // Prepare stock for shutdown: stop accepting new orders and drain queues
     void prepareForShutdown();
+
+    // SHARDED mode: queue drains driven by an external shard worker. Each
+    // stock must be pumped by exactly one thread (the queues are
+    // single-consumer). Each call drains up to QUEUE_BATCH_SIZE messages in
+    // one bulk dequeue and returns whether any work was done.
+    bool pumpMatching();
+    bool pumpTradePublisher();
+    bool pumpMarketData();
+    // SHARDED mode: release pending work after running_ goes false (the shard
+    // worker calls this once on exit, mirroring the dedicated workers' drains)
+    void drainShutdown();
+    // SHARDED mode: point producer-side wakeups at the shard worker's load
+    // manager so an enqueue into any of this stock's queues unparks it
+    void setWakeTarget(AdaptiveLoadManager* load_manager) {
+        matching_wake_target_ = load_manager;
+        market_data_wake_target_ = load_manager;
+        trade_wake_target_ = load_manager;
+    }
     
     // Lock-free order submission (called from any thread)
     std::string submitOrder(const Order& order);
     std::string cancelOrder(const std::string& order_id);
+    // Risk pull: cancel every resting order for a user. O(k) in the user's
+    // open orders via the intrusive per-user list.
+    std::string cancelAllForUser(const std::string& user_id);
     Order getOrderStatus(const std::string& order_id);
     
     // Market data (lock-free reads)
+    // This stock's slot in the DailyStatsBoard SoA block
+    size_t statsSlot() const { return stats_slot_; }
     double getLastPrice() const { return static_cast<double>(last_price_.load(std::memory_order_relaxed)) / 100.0; }
     Price getLastPriceFixed() const { return last_price_.load(std::memory_order_relaxed); }
     int64_t getVolume() const { return volume_.load(std::memory_order_relaxed); }
@@ -317,7 +525,7 @@ public:
     Price getDayHighFixed() const { return day_high_.load(std::memory_order_relaxed); }
     Price getDayLowFixed() const { return day_low_.load(std::memory_order_relaxed); }
     Price getDayOpenFixed() const { return open_price_.load(std::memory_order_relaxed); }
-    double getVWAP() const { return vwap_.load(std::memory_order_relaxed); }
+    double getVWAP() const { return static_cast<double>(getVWAPFixed()) / 100.0; }
     Price getVWAPFixed() const;
     
     std::vector<PriceLevel> getTopBids(int count = 5) const;
@@ -9,21 +9,40 @@
 
 #define NOMINMAX
 #include "StockExchange.h"
+#include "BookSnapshot.h"
 #include "CPUAffinity.h"
 #include "../common/EngineLogging.h"
 #include "../api/AuthenticationManager.h"
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <chrono>
 #include <random>
 #include <future>
 #include <utility>
 
-StockExchange::StockExchange(const std::string& db_connection_string) 
+StockExchange::StockExchange(const std::string& db_connection_string)
     : running_(false), market_index_base_value_(1000.0) {  // Start index at 1000 like S&P 500
     if (!db_connection_string.empty()) {
         db_manager_ = std::make_unique<DatabaseManager>(db_connection_string);
     }
+
+    // Opt into the sharded matching architecture via environment
+    if (const char* engine_mode = std::getenv("AUREX_ENGINE_MODE")) {
+        sharded_mode_ = (std::string(engine_mode) == "sharded");
+    }
+
+    // Opt into periodic book snapshots for fast restart
+    if (const char* snapshot_dir = std::getenv("AUREX_SNAPSHOT_DIR")) {
+        snapshot_dir_ = snapshot_dir;
+        if (const char* interval = std::getenv("AUREX_SNAPSHOT_INTERVAL_SEC")) {
+            int seconds = std::atoi(interval);
+            if (seconds > 0) {
+                snapshot_interval_sec_ = seconds;
+            }
+        }
+    }
     
     // Initialize market index
     current_market_index_.index_name = "TECH500";
@@ -39,9 +58,19 @@ StockExchange::~StockExchange() {
 
 bool StockExchange::initialize() {
     ENGINE_LOG_DEV(std::cout << "Initializing Stock Exchange with " << STOCK_SYMBOLS.size() << " stocks..." << std::endl;);
+
+    // Intern the symbol universe in configuration order so wire symbol ids
+    // are deterministic across runs (1-based index; see WireProtocol.h)
+    for (const auto& symbol : STOCK_SYMBOLS) {
+        InternTable::symbols().intern(symbol);
+    }
     
-    // Get available CPU cores for optimal affinity assignment
-    auto available_cores = CPUAffinity::getAvailableCores();
+    // Get available CPU cores in topology placement order: grouped by NUMA
+    // node and shared L3, isolated cores first. Consecutive cores from this
+    // list share a cache domain, so the round-robin triple assignment below
+    // keeps each symbol's matching/md/trade threads - and their SPSC queue
+    // traffic - on one socket.
+    auto available_cores = CPUAffinity::getPlacementCores();
     
     // CRITICAL FIX: Handle single-core or constrained environments
     if (available_cores.empty()) {
@@ -62,36 +91,111 @@ bool StockExchange::initialize() {
         loadFromDatabase();
     }
     
-    // Initialize stocks with different starting prices and CPU affinity
+    // In sharded mode, one shard worker per available core (capped at the
+    // symbol count) owns a partition of symbols instead of 3 threads/symbol
+    size_t shard_count = 0;
+    if (sharded_mode_) {
+        shard_count = (std::min)(available_cores.size(), STOCK_SYMBOLS.size());
+        shard_partitions_.assign(shard_count, {});
+        shard_load_managers_.clear();
+        shard_cores_.clear();
+        for (size_t s = 0; s < shard_count; ++s) {
+            shard_load_managers_.push_back(std::make_unique<AdaptiveLoadManager>());
+            shard_cores_.push_back(available_cores[s % available_cores.size()]);
+        }
+        ENGINE_LOG_DEV(std::cout << "Sharded engine mode: " << shard_count
+                                 << " shard workers for " << STOCK_SYMBOLS.size() << " symbols" << std::endl;);
+    }
+
+    // One batched query replaces the old per-symbol SELECT: the latest price
+    // for the whole universe comes back in a single round trip
+    std::map<std::string, double> db_prices;
+    if (db_manager_ && db_manager_->isConnected()) {
+        for (const auto& stock_data : db_manager_->loadStockData()) {
+            if (stock_data.timestamp_ms > 0) {
+                db_prices[stock_data.symbol] = stock_data.lastPriceToDouble();
+            }
+        }
+    }
+
+    size_t expected_orders = 0;
+    if (const char* expected = std::getenv("AUREX_EXPECTED_ORDERS_PER_SYMBOL")) {
+        char* end = nullptr;
+        unsigned long long count = std::strtoull(expected, &end, 10);
+        if (end != expected && count > 0) {
+            expected_orders = static_cast<size_t>(count);
+        }
+    }
+
+    // Initialize stocks with different starting prices and CPU affinity.
+    // Construction (pool arenas, order index, queues) is the expensive part
+    // and is independent per stock, so it runs on one task per symbol; the
+    // wiring below stays on this thread in symbol order so shard assignment
+    // and callbacks are deterministic. Threads only spawn later in start().
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> price_dist(50.0, 200.0);
-    
+
+    std::vector<double> initial_prices(STOCK_SYMBOLS.size());
+    std::vector<std::future<std::unique_ptr<Stock>>> constructions;
+    constructions.reserve(STOCK_SYMBOLS.size());
+
     for (size_t i = 0; i < STOCK_SYMBOLS.size(); ++i) {
         const auto& symbol = STOCK_SYMBOLS[i];
         double initial_price = price_dist(gen);
-        
+
         // If we have database data, use that instead
-        if (db_manager_ && db_manager_->isConnected()) {
-            auto stock_data = db_manager_->getLatestStockData(symbol);
-            if (stock_data.timestamp_ms > 0) {
-                initial_price = stock_data.lastPriceToDouble();
-            }
+        auto price_it = db_prices.find(symbol);
+        if (price_it != db_prices.end()) {
+            initial_price = price_it->second;
         }
-        
+        initial_prices[i] = initial_price;
+
         // Assign CPU cores in round-robin fashion
         // Each stock needs 3 cores: matching, market data, trade publisher
         int base_core = (i * 3) % available_cores.size();
         int matching_core = available_cores[base_core];
         int md_core = available_cores[(base_core + 1) % available_cores.size()];
         int trade_core = available_cores[(base_core + 2) % available_cores.size()];
-        
-        stocks_[symbol] = std::make_unique<Stock>(symbol, initial_price, 
-                                                  matching_core, md_core, trade_core);
+
+        latest_market_data_[symbol]; // Create the conflation slot up front
+
+        auto mode = sharded_mode_ ? StockThreadingMode::SHARDED
+                                  : StockThreadingMode::DEDICATED;
+        constructions.push_back(std::async(
+            std::launch::async,
+            [symbol, initial_price, matching_core, md_core, trade_core, mode,
+             expected_orders]() {
+                // Construct on the stock's own matching core so first-touch
+                // places the pool arenas on that core's NUMA node
+                CPUAffinity::setThreadAffinity(matching_core);
+                auto stock = std::make_unique<Stock>(symbol, initial_price,
+                                                     matching_core, md_core, trade_core,
+                                                     mode);
+                // Pre-size the order index for the expected daily open-order
+                // count and fault in the pool arenas while we're off the
+                // critical path
+                if (expected_orders > 0) {
+                    stock->reserveOrderCapacity(expected_orders);
+                }
+                stock->prewarmPools();
+                return stock;
+            }));
+    }
+
+    for (size_t i = 0; i < STOCK_SYMBOLS.size(); ++i) {
+        const auto& symbol = STOCK_SYMBOLS[i];
+        stocks_[symbol] = constructions[i].get();
+
+        if (sharded_mode_) {
+            shard_partitions_[i % shard_count].push_back(stocks_[symbol].get());
+            // Enqueues into any of this stock's queues unpark its shard worker
+            stocks_[symbol]->setWakeTarget(shard_load_managers_[i % shard_count].get());
+        }
             stocks_[symbol]->setTradeCallback([this](const Trade& trade) {
                 dispatchTrade(trade);
             });
-            
+
             // SEC Compliance: Set order status callback for persistence
             stocks_[symbol]->setOrderStatusCallback([this](const Order& order) {
                 if (db_manager_ && db_manager_->isConnected()) {
@@ -113,11 +217,32 @@ bool StockExchange::initialize() {
             stocks_[symbol]->setReservationHandlers(reserve_callback_, release_callback_);
         }
         
-    ENGINE_LOG_DEV(std::cout << "Initialized " << symbol << " at $" << initial_price
-                 << " (cores: " << matching_core << "," << md_core
-                 << "," << trade_core << ")" << std::endl;);
+    ENGINE_LOG_DEV(std::cout << "Initialized " << symbol << " at $" << initial_prices[i]
+                 << " (cores: " << available_cores[(i * 3) % available_cores.size()]
+                 << "," << available_cores[(i * 3 + 1) % available_cores.size()]
+                 << "," << available_cores[(i * 3 + 2) % available_cores.size()]
+                 << ")" << std::endl;);
     }
-    
+
+    // Rebuild resting book state from the last binary snapshot before any
+    // worker threads start (the persistence journal was already replayed into
+    // PostgreSQL inside db_manager_->connect())
+    if (!snapshot_dir_.empty()) {
+        loadBookSnapshots();
+    }
+
+    // Build the snapshot sweep plan: symbol, stats slot and Stock in stocks_
+    // iteration order, so getAllStocksSnapshot never walks the map
+    snapshot_order_.clear();
+    snapshot_order_.reserve(stocks_.size());
+    for (const auto& [symbol, stock] : stocks_) {
+        snapshot_order_.push_back({symbol, stock->statsSlot(), stock.get()});
+    }
+
+    // Seed the incremental index state from the freshly initialized stocks;
+    // from here on dispatchTrade keeps it current one delta at a time
+    seedIndexState();
+
     return true;
 }
 
@@ -134,8 +259,24 @@ void StockExchange::start() {
         stock->start();
     }
     
+    // In sharded mode, spawn one pinned worker per shard to drive its partition
+    if (sharded_mode_) {
+        for (size_t s = 0; s < shard_partitions_.size(); ++s) {
+            shard_threads_.emplace_back(&StockExchange::shardWorker, this, s);
+            CPUAffinity::setThreadAffinity(shard_threads_.back(), shard_cores_[s]);
+            CPUAffinity::setHighPriority(shard_threads_.back());
+        }
+        ENGINE_LOG_DEV(std::cout << "Started " << shard_threads_.size()
+                                 << " shard workers" << std::endl;);
+    }
+
     // Start index calculation thread
     index_thread_ = std::thread(&StockExchange::indexWorker, this);
+
+    // Start periodic book snapshot thread
+    if (!snapshot_dir_.empty()) {
+        snapshot_thread_ = std::thread(&StockExchange::snapshotWorker, this);
+    }
     
     // Start database sync thread
     if (db_manager_) {
@@ -155,9 +296,10 @@ void StockExchange::stop() {
     ENGINE_LOG_DEV(std::cout << "Stopping StockExchange..." << std::endl;);
     running_.store(false);
     
-    // Wake up the database sync thread
+    // Wake up the database sync and index publisher threads
     db_sync_cv_.notify_all();
-    
+    index_cv_.notify_all();
+
     // Stop all stock threads with progress indicator and timeout protection
     ENGINE_LOG_DEV(std::cout << "Stopping " << stocks_.size() << " stock threads..." << std::endl;);
     size_t stopped = 0;
@@ -180,7 +322,41 @@ void StockExchange::stop() {
         stopped++;
     }
     std::cout << "✓ All " << stopped << " stock threads stopped" << std::endl;
-    
+
+    // Join shard workers (they drain their stocks' queues on the way out)
+    if (!shard_threads_.empty()) {
+        std::cout << "✓ Stopping " << shard_threads_.size() << " shard workers..." << std::flush;
+        for (auto& shard_thread : shard_threads_) {
+            if (!shard_thread.joinable()) continue;
+            auto future = std::async(std::launch::async, [&shard_thread]() {
+                shard_thread.join();
+            });
+            if (future.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout) {
+                std::cerr << "Warning: shard worker timeout, detaching" << std::endl;
+                shard_thread.detach();
+            }
+        }
+        shard_threads_.clear();
+        std::cout << " done" << std::endl;
+    }
+
+    // Stop snapshot thread, then capture one final snapshot of the now
+    // quiescent books so the next start restores the true end-of-session state
+    if (snapshot_thread_.joinable()) {
+        std::cout << "✓ Stopping snapshot thread..." << std::flush;
+        auto future = std::async(std::launch::async, [this]() {
+            snapshot_thread_.join();
+        });
+        if (future.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout) {
+            std::cerr << "Warning: snapshot thread timeout, detaching" << std::endl;
+            snapshot_thread_.detach();
+        }
+        std::cout << " done" << std::endl;
+    }
+    if (!snapshot_dir_.empty()) {
+        writeBookSnapshots();
+    }
+
     // Stop index thread with timeout
     std::cout << "✓ Stopping index thread..." << std::flush;
     if (index_thread_.joinable()) {
@@ -239,6 +415,43 @@ std::string StockExchange::submitOrder(const std::string& symbol, const Order& o
     return result;
 }
 
+std::string StockExchange::cancelOrder(const std::string& symbol, const std::string& order_id) {
+    if (!running_.load(std::memory_order_acquire)) {
+        return "rejected: exchange not running";
+    }
+
+    auto it = stocks_.find(symbol);
+    if (it == stocks_.end()) {
+        return "Symbol not found";
+    }
+
+    return it->second->cancelOrder(order_id);
+}
+
+size_t StockExchange::cancelAllForUser(const std::string& user_id) {
+    if (!running_.load(std::memory_order_acquire)) {
+        return 0;
+    }
+
+    // Fan the risk pull out to every symbol; each matching thread walks just
+    // that user's intrusive open-order list
+    size_t submitted = 0;
+    for (auto& [symbol, stock] : stocks_) {
+        if (stock->cancelAllForUser(user_id) == "cancel all submitted") {
+            ++submitted;
+        }
+    }
+    return submitted;
+}
+
+uint64_t StockExchange::totalOrdersProcessed() const {
+    uint64_t total = 0;
+    for (const auto& [symbol, stock] : stocks_) {
+        total += stock->getOrdersProcessed();
+    }
+    return total;
+}
+
 Order StockExchange::getOrderStatus(const std::string& symbol, const std::string& order_id) {
     auto it = stocks_.find(symbol);
     if (it == stocks_.end()) {
@@ -269,9 +482,21 @@ MarketDataUpdate StockExchange::getMarketData(const std::string& symbol) {
 
 std::vector<IndexEntry> StockExchange::getTopIndex(const std::string& criterion, int top_n) {
     std::lock_guard<std::mutex> lock(index_mutex_);
-    
+
+    // Top-by-volume is maintained incrementally per trade, so the common
+    // query is a bounded copy with no sort
+    if (criterion == "volume" && top_n <= TOP_VOLUME_SLOTS) {
+        std::vector<IndexEntry> top;
+        size_t count = (std::min)(top_volume_count_, static_cast<size_t>(top_n));
+        top.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            top.push_back(current_index_[top_volume_slots_[i]]);
+        }
+        return top;
+    }
+
     std::vector<IndexEntry> sorted_index = current_index_;
-    
+
     if (criterion == "volume") {
         std::sort(sorted_index.begin(), sorted_index.end(),
                  [](const IndexEntry& a, const IndexEntry& b) {
@@ -331,17 +556,156 @@ void StockExchange::unsubscribeFromAllStocks() {
     all_stocks_subscribers_.clear();
 }
 
+void StockExchange::shardWorker(size_t shard_id) {
+    auto& stocks = shard_partitions_[shard_id];
+    AdaptiveLoadManager& load_manager = *shard_load_managers_[shard_id];
+    load_manager.reset();
+
+    ENGINE_LOG_DEV(std::cout << "Shard worker " << shard_id << " started with "
+                             << stocks.size() << " symbols" << std::endl;);
+
+    while (running_.load(std::memory_order_acquire)) {
+        uint32_t wake_token = load_manager.prepareWait();
+        bool did_work = false;
+
+        // Round-robin through this shard's symbols, pumping all three queues.
+        // Each queue keeps its single-consumer guarantee: this worker is the
+        // only thread that ever dequeues from these stocks.
+        for (Stock* stock : stocks) {
+            did_work |= stock->pumpMatching();
+            did_work |= stock->pumpTradePublisher();
+            did_work |= stock->pumpMarketData();
+        }
+
+        load_manager.recordIteration(did_work);
+        if (!did_work) {
+            load_manager.waitForWork(wake_token);
+        }
+    }
+
+    // Drain any remaining messages so reservations are released on shutdown
+    for (Stock* stock : stocks) {
+        stock->drainShutdown();
+    }
+
+    ENGINE_LOG_DEV(std::cout << "Shard worker " << shard_id << " stopped" << std::endl;);
+}
+
+void StockExchange::snapshotWorker() {
+    // Short ticks so shutdown is not held up by a long interval sleep
+    auto next_snapshot = std::chrono::steady_clock::now() +
+                         std::chrono::seconds(snapshot_interval_sec_);
+    while (running_.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!running_.load() || std::chrono::steady_clock::now() < next_snapshot) {
+            continue;
+        }
+        writeBookSnapshots();
+        next_snapshot = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(snapshot_interval_sec_);
+    }
+}
+
+void StockExchange::writeBookSnapshots() {
+    int64_t taken_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    for (auto& [symbol, stock] : stocks_) {
+        std::vector<Order> open_orders = stock->collectOpenOrders();
+
+        std::vector<SnapshotOrderRecord> records;
+        records.reserve(open_orders.size());
+        for (const auto& order : open_orders) {
+            SnapshotOrderRecord record{};
+            std::strncpy(record.order_id, order.order_id.c_str(), sizeof(record.order_id) - 1);
+            std::strncpy(record.user_id, order.user_id.c_str(), sizeof(record.user_id) - 1);
+            std::strncpy(record.symbol, symbol.c_str(), sizeof(record.symbol) - 1);
+            record.side = order.side;
+            record.type = order.type;
+            record.quantity = order.quantity;
+            record.remaining_qty = order.remaining_qty;
+            record.price = order.price;
+            record.timestamp_ms = order.timestamp_ms;
+            record.order_seq = order.order_seq;
+            records.push_back(record);
+        }
+
+        BookSnapshot::write(snapshot_dir_ + "/" + symbol + ".book",
+                            taken_at_ms, records);
+    }
+}
+
+void StockExchange::loadBookSnapshots() {
+    auto load_start = std::chrono::steady_clock::now();
+    size_t restored = 0;
+
+    for (auto& [symbol, stock] : stocks_) {
+        int64_t taken_at_ms = 0;
+        std::vector<SnapshotOrderRecord> records;
+        if (!BookSnapshot::read(snapshot_dir_ + "/" + symbol + ".book",
+                                taken_at_ms, records)) {
+            continue;
+        }
+
+        // Restore in original arrival order so price-time priority inside
+        // each level matches the pre-restart book
+        std::sort(records.begin(), records.end(),
+                  [](const SnapshotOrderRecord& a, const SnapshotOrderRecord& b) {
+                      if (a.timestamp_ms != b.timestamp_ms) {
+                          return a.timestamp_ms < b.timestamp_ms;
+                      }
+                      return a.order_seq < b.order_seq;
+                  });
+
+        for (const auto& record : records) {
+            Order order(record.order_id, record.user_id, record.symbol,
+                        record.side, record.type, record.quantity,
+                        record.price, record.timestamp_ms);
+            order.remaining_qty = record.remaining_qty;
+            if (order.remaining_qty < order.quantity) {
+                order.status = "partial";
+            }
+            order.order_seq = record.order_seq;
+
+            if (stock->restoreOrder(order)) {
+                restored++;
+            }
+        }
+    }
+
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - load_start).count();
+    ENGINE_LOG_DEV(std::cout << "Restored " << restored
+                             << " resting orders from book snapshots in "
+                             << elapsed_ms << "ms" << std::endl;);
+}
+
 void StockExchange::indexWorker() {
+    // The heavy lifting moved to applyTradeToIndex (O(1) per trade); this
+    // thread only publishes, woken by the first trade after a quiet spell
+    // and otherwise at most once per wait period, so a burst of trades is
+    // conflated into one broadcast instead of one per tick
+    auto next_all_stocks = std::chrono::steady_clock::now();
     while (running_.load()) {
-        calculateIndex();
-        calculateMarketIndex();
-        broadcastIndex();
-        broadcastMarketIndex();
-        broadcastAllStocks();
-        
-        // Sleep in small increments to be responsive to shutdown
-        for (int i = 0; i < 10 && running_.load(); ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        {
+            std::unique_lock<std::mutex> lock(index_cv_mutex_);
+            index_cv_.wait_for(lock, std::chrono::milliseconds(250), [this]() {
+                return !running_.load() || index_dirty_.load(std::memory_order_acquire);
+            });
+        }
+        if (!running_.load()) break;
+
+        if (index_dirty_.exchange(false, std::memory_order_acq_rel)) {
+            broadcastIndex();
+            broadcastMarketIndex();
+        }
+
+        // The all-stocks snapshot includes book depth, so it stays on a
+        // coarse timer rather than following every trade
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_all_stocks) {
+            broadcastAllStocks();
+            next_all_stocks = now + std::chrono::seconds(1);
         }
     }
 }
@@ -359,71 +723,123 @@ void StockExchange::databaseSyncWorker() {
     }
 }
 
-void StockExchange::calculateIndex() {
-    std::lock_guard<std::mutex> lock(index_mutex_);
+void StockExchange::seedIndexState() {
+    std::scoped_lock lock(index_mutex_, market_index_mutex_);
     current_index_.clear();
-    
-    for (const auto& [symbol, stock] : stocks_) {
-        IndexEntry entry(
-            symbol,
-            stock->getLastPriceFixed(),
-            stock->getChangePercent(),
-            stock->getVolume()
-        );
-        current_index_.push_back(entry);
+    index_slot_by_symbol_.clear();
+    index_price_sum_ = 0.0;
+    top_volume_count_ = 0;
+    current_market_index_.constituents.clear();
+
+    for (const auto& symbol : STOCK_SYMBOLS) {
+        auto& stock = stocks_[symbol];
+        size_t slot = current_index_.size();
+        index_slot_by_symbol_[symbol] = slot;
+        current_index_.emplace_back(symbol, stock->getLastPriceFixed(),
+                                    stock->getChangePercent(), stock->getVolume());
+        index_price_sum_ += static_cast<double>(stock->getLastPriceFixed()) / 100.0;
+    }
+
+    // Constituents are kept slot-aligned with current_index_ so a trade
+    // updates exactly one entry in place. Weights are equal, as before.
+    const double weight = current_index_.empty() ? 0.0
+                        : 1.0 / static_cast<double>(current_index_.size());
+    for (const auto& entry : current_index_) {
+        double price = entry.priceToDouble();
+        current_market_index_.constituents.emplace_back(
+            entry.symbol, entry.last_price, weight,
+            (price * weight / market_index_base_value_) * 100, entry.change_pct);
+    }
+
+    if (!current_index_.empty()) {
+        double index_value = (index_price_sum_ / static_cast<double>(current_index_.size()))
+                             * (market_index_base_value_ / 100.0);
+        current_market_index_.index_value = index_value;
+        current_market_index_.day_open = index_value;
+        current_market_index_.day_high = index_value;
+        current_market_index_.day_low = index_value;
+        current_market_index_.change_points = 0.0;
+        current_market_index_.change_percent = 0.0;
+    }
+    current_market_index_.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    for (size_t slot = 0; slot < current_index_.size(); ++slot) {
+        if (current_index_[slot].volume > 0) {
+            bumpTopVolumeSlot(slot);
+        }
     }
 }
 
-void StockExchange::calculateMarketIndex() {
-    std::lock_guard<std::mutex> lock(market_index_mutex_);
-    
-    // Calculate index based on top 5 performing stocks (by market cap simulation)
-    std::vector<std::pair<std::string, double>> stock_values;
-    
-    for (const auto& [symbol, stock] : stocks_) {
-    double price_dollars = stock->getLastPrice() ;
-    double market_cap = price_dollars * stock->getVolume(); // Simplified market cap
-        stock_values.emplace_back(symbol, market_cap);
+void StockExchange::bumpTopVolumeSlot(size_t slot) {
+    // Caller holds index_mutex_. Keeps the bounded top-by-volume list sorted
+    // descending; per-symbol volume only grows, so an update either bubbles
+    // an existing entry up or displaces the smallest entry.
+    size_t pos = top_volume_count_;
+    for (size_t i = 0; i < top_volume_count_; ++i) {
+        if (top_volume_slots_[i] == slot) {
+            pos = i;
+            break;
+        }
     }
-    
-    // Sort by market cap (descending)
-    std::sort(stock_values.begin(), stock_values.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    // Take all stocks for index calculation (instead of top 5)
-    int constituents_count = static_cast<int>(stock_values.size());
-    current_market_index_.constituents.clear();
-    
-    double total_weight = 0.0;
-    double weighted_price_sum = 0.0;
-    
-    for (int i = 0; i < constituents_count; ++i) {
-        const std::string& symbol = stock_values[i].first;
-        auto& stock = stocks_[symbol];
-        
-        // Use equal weights for all stocks
-        double weight = 1.0 / constituents_count;
-        total_weight += weight;
-        
-    Price price_fixed = stock->getLastPriceFixed();
-    double price = static_cast<double>(price_fixed) / 100.0;
-        double change_pct = stock->getChangePercent();
-        
-        weighted_price_sum += price * weight;
-        
-        // Calculate contribution to index
-        double contribution = (price * weight / market_index_base_value_) * 100;
-        
-        current_market_index_.constituents.emplace_back(
-            symbol, price_fixed, weight, contribution, change_pct
-        );
+    if (pos == top_volume_count_) {
+        if (top_volume_count_ < static_cast<size_t>(TOP_VOLUME_SLOTS)) {
+            top_volume_slots_[top_volume_count_++] = slot;
+        } else if (current_index_[slot].volume >
+                   current_index_[top_volume_slots_[top_volume_count_ - 1]].volume) {
+            pos = top_volume_count_ - 1;
+            top_volume_slots_[pos] = slot;
+        } else {
+            return;
+        }
     }
-    
-    // Calculate new index value
-    if (total_weight > 0) {
-        double new_index_value = (weighted_price_sum / total_weight) * (market_index_base_value_ / 100.0);
-        
-        // Update daily stats
+    while (pos > 0 && current_index_[top_volume_slots_[pos]].volume >
+                      current_index_[top_volume_slots_[pos - 1]].volume) {
+        std::swap(top_volume_slots_[pos], top_volume_slots_[pos - 1]);
+        --pos;
+    }
+}
+
+void StockExchange::applyTradeToIndex(const Trade& trade) {
+    double change_pct = 0.0;
+    auto stock_it = stocks_.find(trade.symbol);
+    if (stock_it != stocks_.end()) {
+        change_pct = stock_it->second->getChangePercent();
+    }
+
+    const double price_dollars = static_cast<double>(trade.price) / 100.0;
+    size_t slot;
+    size_t symbol_count;
+    double price_sum;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        auto it = index_slot_by_symbol_.find(trade.symbol);
+        if (it == index_slot_by_symbol_.end()) {
+            return;
+        }
+        slot = it->second;
+        IndexEntry& entry = current_index_[slot];
+        index_price_sum_ += price_dollars - static_cast<double>(entry.last_price) / 100.0;
+        entry.last_price = trade.price;
+        entry.volume += trade.quantity;
+        entry.change_pct = change_pct;
+        bumpTopVolumeSlot(slot);
+        symbol_count = current_index_.size();
+        price_sum = index_price_sum_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(market_index_mutex_);
+        if (slot < current_market_index_.constituents.size()) {
+            IndexConstituent& constituent = current_market_index_.constituents[slot];
+            constituent.last_price = trade.price;
+            constituent.change_percent = change_pct;
+            constituent.contribution =
+                (price_dollars * constituent.weight / market_index_base_value_) * 100;
+        }
+
+        double new_index_value = (price_sum / static_cast<double>(symbol_count))
+                                 * (market_index_base_value_ / 100.0);
         if (current_market_index_.index_value == 0) {
             current_market_index_.day_open = new_index_value;
             current_market_index_.day_high = new_index_value;
@@ -432,16 +848,20 @@ void StockExchange::calculateMarketIndex() {
             current_market_index_.day_high = (std::max)(current_market_index_.day_high, new_index_value);
             current_market_index_.day_low = (std::min)(current_market_index_.day_low, new_index_value);
         }
-        
-        // Calculate changes
         current_market_index_.change_points = new_index_value - current_market_index_.day_open;
-        current_market_index_.change_percent = (current_market_index_.change_points / current_market_index_.day_open) * 100.0;
-        
+        current_market_index_.change_percent = current_market_index_.day_open != 0.0
+            ? (current_market_index_.change_points / current_market_index_.day_open) * 100.0
+            : 0.0;
         current_market_index_.index_value = new_index_value;
+        current_market_index_.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Wake the publisher only on the idle->dirty edge; a burst of trades
+    // sets the flag once and gets conflated into a single broadcast
+    if (!index_dirty_.exchange(true, std::memory_order_acq_rel)) {
+        index_cv_.notify_one();
     }
-    
-    current_market_index_.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
 MarketIndex StockExchange::getMarketIndex(const std::string& index_name) {
@@ -450,28 +870,37 @@ MarketIndex StockExchange::getMarketIndex(const std::string& index_name) {
 }
 
 std::vector<StockSnapshot> StockExchange::getAllStocksSnapshot(bool include_order_book) {
-    std::vector<StockSnapshot> snapshots;
-    
-    for (const auto& [symbol, stock] : stocks_) {
-        StockSnapshot snapshot;
-        snapshot.symbol = symbol;
-    snapshot.last_price = stock->getLastPriceFixed();
-    snapshot.change_points = stock->getChangePointsFixed();
-        snapshot.change_percent = stock->getChangePercent();
-    snapshot.day_high = stock->getDayHighFixed();
-    snapshot.day_low = stock->getDayLowFixed();
-    snapshot.day_open = stock->getDayOpenFixed();
-        snapshot.volume = stock->getVolume();
-    snapshot.vwap = stock->getVWAPFixed();
-        
+    // Linear sweep over the DailyStatsBoard SoA block into a buffer sized up
+    // front: one relaxed load per field per symbol plus the change math,
+    // instead of ~10 getter calls bouncing between every Stock's cache lines
+    auto& stats = DailyStatsBoard::instance();
+    std::vector<StockSnapshot> snapshots(snapshot_order_.size());
+
+    for (size_t i = 0; i < snapshot_order_.size(); ++i) {
+        const SnapshotSource& source = snapshot_order_[i];
+        StockSnapshot& snapshot = snapshots[i];
+        const size_t slot = source.stats_slot;
+
+        const Price last = stats.last(slot).load(std::memory_order_relaxed);
+        const Price open = stats.open(slot).load(std::memory_order_relaxed);
+        snapshot.symbol = source.symbol;
+        snapshot.last_price = last;
+        snapshot.change_points = last - open;
+        snapshot.change_percent = (open != 0)
+            ? (static_cast<double>(last - open) / static_cast<double>(open)) * 100.0
+            : 0.0;
+        snapshot.day_high = stats.high(slot).load(std::memory_order_relaxed);
+        snapshot.day_low = stats.low(slot).load(std::memory_order_relaxed);
+        snapshot.day_open = open;
+        snapshot.volume = stats.volume(slot).load(std::memory_order_relaxed);
+        snapshot.vwap = source.stock->getVWAPFixed();
+
         if (include_order_book) {
-            snapshot.top_bids = stock->getTopBids(3);
-            snapshot.top_asks = stock->getTopAsks(3);
+            snapshot.top_bids = source.stock->getTopBids(3);
+            snapshot.top_asks = source.stock->getTopAsks(3);
         }
-        
-        snapshots.push_back(snapshot);
     }
-    
+
     return snapshots;
 }
 
@@ -487,15 +916,42 @@ void StockExchange::broadcastMarketData(const std::string& symbol) {
         }
     }
     
-    // Invoke callbacks without holding the lock
-    if (!callbacks_snapshot.empty()) {
-        MarketDataUpdate update = getMarketData(symbol);
-        for (const auto& callback : callbacks_snapshot) {
-            callback(update);
-        }
+    // This runs on the submit path for every accepted order: build nothing
+    // unless a subscriber or a conflation poller is actually consuming
+    if (callbacks_snapshot.empty() &&
+        !market_data_polled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Publish one immutable snapshot: the conflation slot is overwritten in
+    // place, so consumers that lag simply skip to the newest state
+    auto update = std::make_shared<const MarketDataUpdate>(getMarketData(symbol));
+    auto slot = latest_market_data_.find(symbol);
+    if (slot != latest_market_data_.end()) {
+        slot->second.store(update, std::memory_order_release);
+    }
+
+    // Invoke callbacks without holding the lock; they all share the same
+    // immutable snapshot instead of receiving per-subscriber copies
+    for (const auto& callback : callbacks_snapshot) {
+        callback(*update);
     }
 }
 
+std::shared_ptr<const MarketDataUpdate> StockExchange::latestMarketData(const std::string& symbol) const {
+    // Register conflation interest: publishing starts with the first poll
+    // (pollers tolerate nullptr before the first broadcast anyway)
+    if (!market_data_polled_.load(std::memory_order_relaxed)) {
+        market_data_polled_.store(true, std::memory_order_relaxed);
+    }
+
+    auto it = latest_market_data_.find(symbol);
+    if (it == latest_market_data_.end()) {
+        return nullptr;
+    }
+    return it->second.load(std::memory_order_acquire);
+}
+
 void StockExchange::broadcastIndex() {
     // CRITICAL FIX: Snapshot callbacks under lock, then invoke without holding lock
     std::vector<IndexUpdateCallback> callbacks_snapshot;
@@ -543,13 +999,13 @@ void StockExchange::broadcastAllStocks() {
         callbacks_snapshot = all_stocks_subscribers_;
     }
     
-    // Invoke callbacks without holding the lock
-    if (!callbacks_snapshot.empty()) {
-        std::vector<StockSnapshot> snapshots = getAllStocksSnapshot(true);
-        
-        for (const auto& callback : callbacks_snapshot) {
-            callback(snapshots);
-        }
+    // Publish one immutable snapshot per tick for conflating consumers
+    auto snapshots = std::make_shared<const std::vector<StockSnapshot>>(getAllStocksSnapshot(true));
+    latest_all_stocks_.store(snapshots, std::memory_order_release);
+
+    // Invoke callbacks without holding the lock, all sharing the snapshot
+    for (const auto& callback : callbacks_snapshot) {
+        callback(*snapshots);
     }
 }
 
@@ -568,6 +1024,9 @@ void StockExchange::dispatchTrade(const Trade& trade) {
         );
     }
     
+    // O(1) index delta; the index thread publishes when flagged dirty
+    applyTradeToIndex(trade);
+
     // Dispatch to subscribers
     std::vector<TradeCallback> callbacks_snapshot;
     {
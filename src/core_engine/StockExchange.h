@@ -10,6 +10,7 @@
 #pragma once
 #include "Stock.h"
 #include "DatabaseManager.h"
+#include <array>
 #include <map>
 #include <memory>
 #include <vector>
@@ -120,21 +121,67 @@ using AllStocksCallback = std::function<void(const std::vector<StockSnapshot>&)>
 
 class StockExchange {
 private:
-    // Stock symbols to initialize (temporarily reduced for performance tuning)
+    // Stock symbols to initialize. In sharded mode the engine thread count is
+    // independent of this list, so it can grow to the full production universe.
     const std::vector<std::string> STOCK_SYMBOLS = {
-        "AAPL", "MSFT"
+        "AAPL", "MSFT", "GOOGL", "AMZN", "TSLA"
     };
-    
+
     std::map<std::string, std::unique_ptr<Stock>> stocks_;
+    // Snapshot sweep plan, built once in initialize(): per symbol (in
+    // stocks_ iteration order) its DailyStatsBoard slot and Stock, so
+    // getAllStocksSnapshot walks flat arrays instead of the map
+    struct SnapshotSource {
+        std::string symbol;
+        size_t stats_slot;
+        Stock* stock;
+    };
+    std::vector<SnapshotSource> snapshot_order_;
     std::unique_ptr<DatabaseManager> db_manager_;
-    
+
     // Threading
     std::atomic<bool> running_;
     std::thread index_thread_;
     std::thread db_sync_thread_;
     std::mutex db_sync_mutex_;
     std::condition_variable db_sync_cv_;
-    
+
+    // Sharded matching mode (AUREX_ENGINE_MODE=sharded): N shard workers
+    // (N = available cores, capped at the symbol count) each own a partition
+    // of symbols and drive their queues, instead of 3 dedicated threads per
+    // symbol. Keeps thread count constant as the symbol list grows.
+    bool sharded_mode_{false};
+    std::vector<std::thread> shard_threads_;
+    std::vector<std::vector<Stock*>> shard_partitions_;
+    std::vector<std::unique_ptr<AdaptiveLoadManager>> shard_load_managers_;
+    std::vector<int> shard_cores_;
+    void shardWorker(size_t shard_id);
+
+    // Periodic binary book snapshots for fast restart (see BookSnapshot.h).
+    // Enabled by setting AUREX_SNAPSHOT_DIR; one <symbol>.book file per stock,
+    // rewritten every AUREX_SNAPSHOT_INTERVAL_SEC (default 30s) and once more
+    // on clean shutdown. initialize() restores resting orders from these files
+    // before the worker threads start, so a restart rebuilds full book state
+    // instead of waiting on re-submission.
+    std::string snapshot_dir_;
+    int snapshot_interval_sec_{30};
+    std::thread snapshot_thread_;
+    void snapshotWorker();
+    void writeBookSnapshots();
+    void loadBookSnapshots();
+
+    // Conflating fan-out: each broadcast publishes one immutable heap
+    // snapshot into an atomic slot; consumers poll the slot at their own pace
+    // and a lagging consumer just observes fewer, newer snapshots. Publisher
+    // cost is one snapshot build plus one pointer store regardless of how
+    // many consumers attach, and a slow consumer can no longer stall anyone.
+    std::atomic<std::shared_ptr<const std::vector<StockSnapshot>>> latest_all_stocks_{nullptr};
+    std::map<std::string, std::atomic<std::shared_ptr<const MarketDataUpdate>>> latest_market_data_;
+    // Set on the first latestMarketData() poll. broadcastMarketData runs on
+    // the order-submit path, so it skips the snapshot build entirely until a
+    // callback subscriber or conflation poller actually consumes updates.
+    mutable std::atomic<bool> market_data_polled_{false};
+
     // Market data streaming
     mutable std::mutex subscribers_mutex_;
     std::map<std::string, std::vector<MarketDataCallback>> market_data_subscribers_;
@@ -148,19 +195,32 @@ private:
     OrderReleaseCallback release_callback_;
     bool trade_observer_registered_{false};
     
-    // Index calculation
+    // Incremental index maintenance: dispatchTrade applies an O(1) delta to
+    // the per-symbol entry, the equal-weight price sum and the bounded
+    // top-by-volume list, instead of the index thread rescanning and
+    // re-sorting every stock on a timer. The index thread only publishes,
+    // and only after something changed.
     mutable std::mutex index_mutex_;
-    std::vector<IndexEntry> current_index_;
-    
+    std::vector<IndexEntry> current_index_;              // One slot per symbol, config order
+    std::map<std::string, size_t> index_slot_by_symbol_;
+    double index_price_sum_{0.0};                        // Sum of last prices (dollars)
+    static constexpr int TOP_VOLUME_SLOTS = 5;
+    std::array<size_t, TOP_VOLUME_SLOTS> top_volume_slots_{};  // Slot indices, volume desc
+    size_t top_volume_count_{0};
+    std::atomic<bool> index_dirty_{false};
+    std::condition_variable index_cv_;
+    std::mutex index_cv_mutex_;
+    void seedIndexState();
+    void applyTradeToIndex(const Trade& trade);
+    void bumpTopVolumeSlot(size_t slot);  // Requires index_mutex_ held
+
     // Market Index calculation (like S&P 500)
     mutable std::mutex market_index_mutex_;
     MarketIndex current_market_index_;
     double market_index_base_value_;  // Base value for index calculation
-    
+
     void indexWorker();
     void databaseSyncWorker();
-    void calculateIndex();
-    void calculateMarketIndex();
     void broadcastMarketData(const std::string& symbol);
     void broadcastIndex();
     void broadcastMarketIndex();
@@ -177,7 +237,15 @@ public:
     
     // Order management
     std::string submitOrder(const std::string& symbol, const Order& order);
+    std::string cancelOrder(const std::string& symbol, const std::string& order_id);
+    // Risk pull: submit a cancel-all for this user to every symbol's matching
+    // queue. Returns the number of symbols the pull was submitted to.
+    size_t cancelAllForUser(const std::string& user_id);
     Order getOrderStatus(const std::string& symbol, const std::string& order_id);
+
+    // Total messages drained from every matching queue so far; lets load
+    // harnesses wait until submitted flow has been fully processed
+    uint64_t totalOrdersProcessed() const;
     
     // Market data
     MarketDataUpdate getMarketData(const std::string& symbol);
@@ -194,6 +262,13 @@ public:
     void subscribeToIndex(IndexUpdateCallback callback);
     void subscribeToMarketIndex(MarketIndexCallback callback);
     void subscribeToAllStocks(AllStocksCallback callback);
+
+    // Conflated snapshots: the latest published state, or nullptr before the
+    // first broadcast. Consumers detect fresh data by comparing pointers.
+    std::shared_ptr<const std::vector<StockSnapshot>> latestAllStocksSnapshot() const {
+        return latest_all_stocks_.load(std::memory_order_acquire);
+    }
+    std::shared_ptr<const MarketDataUpdate> latestMarketData(const std::string& symbol) const;
     void registerTradeObserver(TradeCallback callback);
     void setAuthenticationManager(AuthenticationManager* manager);
     void unsubscribeFromMarketData(const std::string& symbol);
@@ -9,6 +9,7 @@
 
 #include "api/AuthenticationManager.h"
 #include "api/GRPCServer.h"
+#include "api/MulticastFeed.h"
 #include "api/SharedMemoryQueue.h"
 #include "api/TCPServer.h"
 #include "common/EngineConfig.h"
@@ -696,6 +697,23 @@ int main(int argc, char *argv[]) {
       return -1;
     }
   }
+  // Optional plaintext listener for colocated trusted clients (no TLS);
+  // unset or 0 leaves it disabled
+  if (const std::string trusted_port_env =
+          getEnvOrDefault("AUREX_TCP_TRUSTED_PORT", "");
+      !trusted_port_env.empty()) {
+    try {
+      int parsed_port = std::stoi(trusted_port_env);
+      if (parsed_port < 0 || parsed_port > 65535) {
+        throw std::out_of_range("port range");
+      }
+      engine_config::setTcpTrustedPort(static_cast<uint16_t>(parsed_port));
+    } catch (const std::exception &) {
+      std::cerr << "Invalid AUREX_TCP_TRUSTED_PORT value: '" << trusted_port_env
+                << "'" << std::endl;
+      return -1;
+    }
+  }
   TCPServer tcp_server(tcp_address, tcp_port, service.getExchange(),
                        auth_manager.get());
 
@@ -704,6 +722,9 @@ int main(int argc, char *argv[]) {
   SharedMemoryOrderServer shm_server(shm_name, service.getExchange(),
                                      auth_manager.get());
 
+  // Opt-in UDP multicast market data feed (AUREX_FEED_GROUP)
+  MulticastFeed multicast_feed(service.getExchange());
+
   const std::string grpc_cert_path =
       getEnvOrDefault("AUREX_GRPC_CERT_PATH", "server.crt");
   const std::string grpc_key_path =
@@ -781,6 +802,8 @@ int main(int argc, char *argv[]) {
     std::cerr << "Warning: Failed to start shared memory server" << std::endl;
   }
 
+  multicast_feed.start();
+
   std::atomic<bool> sync_running(true);
   std::mutex sync_mutex;
   std::condition_variable sync_cv;
@@ -839,6 +862,11 @@ int main(int argc, char *argv[]) {
           line += " (" + formatDouble(ops, precision) + "/s)";
         }
         line += " | Avg Lat " + formatLatency(snapshot.averageLatencyUs);
+        if (snapshot.engineLatency.samples > 0) {
+          line += " | p50 " + formatLatency(snapshot.engineLatency.p50Us);
+          line += " | p99 " + formatLatency(snapshot.engineLatency.p99Us);
+          line += " | p99.9 " + formatLatency(snapshot.engineLatency.p999Us);
+        }
         line += " | CPU " +
                 formatDouble(std::max(0.0, snapshot.cpuPercent), 1) + "%";
         line += " | Mem " + formatDouble(snapshot.memoryMb, 1) + " MB";
@@ -1002,6 +1030,11 @@ int main(int argc, char *argv[]) {
     std::cout << "gRPC service stopped" << std::endl;
   }
 
+  if (multicast_feed.enabled()) {
+    multicast_feed.stop();
+    std::cout << "Multicast feed stopped" << std::endl;
+  }
+
   server->Shutdown();
 
   std::cout << "Stock Exchange Server shut down successfully" << std::endl;
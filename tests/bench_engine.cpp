@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026 Ayon Sarkar. All Rights Reserved.
+ *
+ * This source code is licensed under the terms found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * USE FOR EVALUATION ONLY. NO PRODUCTION USE OR COPYING PERMITTED.
+ */
+
+// bench_engine - native load generation and replay harness.
+//
+// Drives StockExchange::submitOrder directly (default) or through the
+// shared-memory fast path (--shm), with either synthetic flow or a replayed
+// JSONL capture, and reports throughput plus submit-latency percentiles.
+// Runs without Postgres/Redis: the exchange is started with no database
+// connection string, so orders skip risk reservation exactly like the unit
+// tests do.
+//
+// Usage:
+//   bench_engine [--orders N]        total operations (default 500000)
+//                [--cancel-ratio P]  percent of ops that are cancels (default 10)
+//                [--skew E]          Zipf exponent for symbol pick; 0 = uniform
+//                                    (default 1.0: first symbol dominates)
+//                [--replay FILE]     replay a JSONL capture instead of
+//                                    generating flow; lines need "symbol",
+//                                    "side", "quantity" and "price_cents"
+//                                    (or dollar "price") fields
+//                [--shm NAME]        drive the shared-memory fast path
+//                                    instead of direct submitOrder calls
+
+#include "../src/core_engine/Stock.h"
+#include "../src/core_engine/StockExchange.h"
+#include "../src/api/SharedMemoryQueue.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+
+namespace {
+
+struct BenchOptions {
+    uint64_t orders = 500000;
+    int cancel_ratio_pct = 10;
+    double skew = 1.0;
+    std::string replay_file;
+    std::string shm_name;
+};
+
+struct BenchOp {
+    bool is_cancel = false;
+    size_t symbol_idx = 0;
+    uint8_t side = 0;       // 0=BUY, 1=SELL
+    uint8_t order_type = 1; // LIMIT
+    int64_t quantity = 0;
+    int64_t price_cents = 0;
+    uint64_t cancel_target = 0; // Index of the order a cancel refers to
+};
+
+bool parseArgs(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            return (i + 1 < argc) ? argv[++i] : nullptr;
+        };
+        if (arg == "--orders") {
+            if (const char* v = next()) opts.orders = std::strtoull(v, nullptr, 10);
+        } else if (arg == "--cancel-ratio") {
+            if (const char* v = next()) opts.cancel_ratio_pct = std::atoi(v);
+        } else if (arg == "--skew") {
+            if (const char* v = next()) opts.skew = std::atof(v);
+        } else if (arg == "--replay") {
+            if (const char* v = next()) opts.replay_file = v;
+        } else if (arg == "--shm") {
+            if (const char* v = next()) opts.shm_name = v;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (opts.cancel_ratio_pct < 0 || opts.cancel_ratio_pct > 90) {
+        std::cerr << "--cancel-ratio must be 0-90" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Minimal field extraction for one JSONL capture line; tolerant of field
+// order and unrelated keys so captures from different tools replay as-is.
+bool extractString(const std::string& line, const std::string& key, std::string& out) {
+    std::string needle = "\"" + key + "\"";
+    size_t pos = line.find(needle);
+    if (pos == std::string::npos) return false;
+    pos = line.find(':', pos + needle.size());
+    if (pos == std::string::npos) return false;
+    pos = line.find('"', pos);
+    if (pos == std::string::npos) return false;
+    size_t end = line.find('"', pos + 1);
+    if (end == std::string::npos) return false;
+    out = line.substr(pos + 1, end - pos - 1);
+    return true;
+}
+
+bool extractNumber(const std::string& line, const std::string& key, double& out) {
+    std::string needle = "\"" + key + "\"";
+    size_t pos = line.find(needle);
+    if (pos == std::string::npos) return false;
+    pos = line.find(':', pos + needle.size());
+    if (pos == std::string::npos) return false;
+    ++pos;
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    char* end = nullptr;
+    out = std::strtod(line.c_str() + pos, &end);
+    return end != line.c_str() + pos;
+}
+
+std::vector<BenchOp> loadReplay(const std::string& path,
+                                const std::vector<std::string>& symbols) {
+    std::vector<BenchOp> ops;
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open replay file: " << path << std::endl;
+        return ops;
+    }
+
+    std::string line;
+    size_t skipped = 0;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        BenchOp op;
+        std::string symbol;
+        double number = 0.0;
+
+        if (!extractString(line, "symbol", symbol)) { ++skipped; continue; }
+        auto it = std::find(symbols.begin(), symbols.end(), symbol);
+        if (it == symbols.end()) { ++skipped; continue; }
+        op.symbol_idx = static_cast<size_t>(it - symbols.begin());
+
+        if (extractNumber(line, "side", number)) op.side = number != 0.0 ? 1 : 0;
+        if (extractNumber(line, "type", number) ||
+            extractNumber(line, "order_type", number)) {
+            op.order_type = static_cast<uint8_t>(number);
+        }
+        if (!extractNumber(line, "quantity", number) || number <= 0.0) { ++skipped; continue; }
+        op.quantity = static_cast<int64_t>(number);
+        if (extractNumber(line, "price_cents", number)) {
+            op.price_cents = static_cast<int64_t>(number);
+        } else if (extractNumber(line, "price", number)) {
+            op.price_cents = Order::fromDouble(number);
+        } else {
+            ++skipped;
+            continue;
+        }
+        ops.push_back(op);
+    }
+
+    if (skipped > 0) {
+        std::cout << "Replay: skipped " << skipped << " unparseable lines" << std::endl;
+    }
+    return ops;
+}
+
+std::vector<BenchOp> generateSynthetic(const BenchOptions& opts,
+                                       const std::vector<std::string>& symbols) {
+    std::vector<BenchOp> ops;
+    ops.reserve(opts.orders);
+
+    std::mt19937_64 gen(42); // Fixed seed so runs are comparable
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int64_t> qty_dist(1, 500);
+    std::uniform_int_distribution<int64_t> tick_dist(-50, 50);
+
+    // Zipf-style cumulative weights: symbol i gets 1/(i+1)^skew of the flow
+    std::vector<double> cumulative(symbols.size());
+    double total = 0.0;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        total += 1.0 / std::pow(static_cast<double>(i + 1), opts.skew);
+        cumulative[i] = total;
+    }
+
+    // Per-symbol mid so buys and sells cross often enough to exercise
+    // matchOrder, not just book insertion
+    std::vector<int64_t> mid(symbols.size(), Order::fromDouble(100.0));
+
+    uint64_t new_orders = 0;
+    for (uint64_t i = 0; i < opts.orders; ++i) {
+        BenchOp op;
+
+        double pick = uniform(gen) * total;
+        op.symbol_idx = static_cast<size_t>(
+            std::lower_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin());
+        if (op.symbol_idx >= symbols.size()) op.symbol_idx = symbols.size() - 1;
+
+        bool cancel = new_orders > 0 &&
+                      uniform(gen) * 100.0 < static_cast<double>(opts.cancel_ratio_pct);
+        if (cancel) {
+            op.is_cancel = true;
+            op.cancel_target = static_cast<uint64_t>(uniform(gen) * static_cast<double>(new_orders));
+        } else {
+            op.side = uniform(gen) < 0.5 ? 0 : 1;
+            op.quantity = qty_dist(gen);
+            mid[op.symbol_idx] += tick_dist(gen) / 10;
+            if (mid[op.symbol_idx] < 100) mid[op.symbol_idx] = 100;
+            op.price_cents = mid[op.symbol_idx] + tick_dist(gen);
+            ++new_orders;
+        }
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+void reportPercentiles(std::vector<uint64_t>& latencies_ns, const char* label) {
+    if (latencies_ns.empty()) {
+        std::cout << "  " << label << ": no samples" << std::endl;
+        return;
+    }
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    auto at = [&](double q) {
+        size_t idx = static_cast<size_t>(q * static_cast<double>(latencies_ns.size() - 1));
+        return static_cast<double>(latencies_ns[idx]) / 1000.0;
+    };
+    std::cout << std::fixed << std::setprecision(2)
+              << "  " << label << ": p50 " << at(0.50) << "us"
+              << "  p99 " << at(0.99) << "us"
+              << "  p99.9 " << at(0.999) << "us"
+              << "  max " << static_cast<double>(latencies_ns.back()) / 1000.0 << "us"
+              << " (" << latencies_ns.size() << " samples)" << std::endl;
+}
+
+// Wait until the matching threads have drained everything we submitted
+bool waitForDrain(StockExchange& exchange, uint64_t expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (exchange.totalOrdersProcessed() < expected) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+
+#ifndef _WIN32
+    if (!opts.shm_name.empty()) {
+        // The fast wire path attributes orders to the configured trusted user
+        setenv("AUREX_SHM_TRUSTED_USER", "BENCH", 0);
+    }
+#endif
+
+    StockExchange exchange; // No database: pure matching-path benchmark
+    if (!exchange.initialize()) {
+        std::cerr << "Failed to initialize exchange" << std::endl;
+        return 1;
+    }
+    exchange.start();
+
+    const std::vector<std::string> symbols = exchange.getSymbols();
+    std::vector<BenchOp> ops = opts.replay_file.empty()
+        ? generateSynthetic(opts, symbols)
+        : loadReplay(opts.replay_file, symbols);
+    if (ops.empty()) {
+        std::cerr << "No operations to run" << std::endl;
+        exchange.stop();
+        return 1;
+    }
+
+    std::cout << "bench_engine: " << ops.size() << " ops over " << symbols.size()
+              << " symbols via " << (opts.shm_name.empty() ? "submitOrder" : "shared memory")
+              << (opts.replay_file.empty() ? " (synthetic)" : " (replay)") << std::endl;
+
+    std::vector<uint64_t> latencies_ns;
+    latencies_ns.reserve(ops.size());
+
+    uint64_t submitted = 0;
+    uint64_t rejected = 0;
+    const int64_t base_ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto run_start = std::chrono::steady_clock::now();
+
+    if (opts.shm_name.empty()) {
+        // Direct path: submitOrder/cancelOrder, order ids are op indices
+        for (uint64_t i = 0; i < ops.size(); ++i) {
+            const BenchOp& op = ops[i];
+            const std::string& symbol = symbols[op.symbol_idx];
+            auto t0 = std::chrono::steady_clock::now();
+            std::string result;
+            if (op.is_cancel) {
+                result = exchange.cancelOrder(symbol, "B" + std::to_string(op.cancel_target));
+            } else {
+                Order order("B" + std::to_string(i), "BENCH", symbol,
+                            op.side, op.order_type, op.quantity, op.price_cents, base_ts);
+                result = exchange.submitOrder(symbol, order);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            latencies_ns.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+            if (result == "accepted" || result == "cancel submitted") {
+                ++submitted;
+            } else {
+                ++rejected;
+            }
+        }
+    } else {
+        // Shared-memory fast path: in-process server + client over the ring.
+        // Cancels have no wire record, so the mix degrades to new orders only.
+        SharedMemoryOrderServer server(opts.shm_name, &exchange, nullptr);
+        if (!server.start()) {
+            std::cerr << "Failed to start shared memory server" << std::endl;
+            exchange.stop();
+            return 1;
+        }
+        SharedMemoryOrderClient client(opts.shm_name);
+        if (!client.connect()) {
+            std::cerr << "Failed to connect shared memory client" << std::endl;
+            server.stop();
+            exchange.stop();
+            return 1;
+        }
+
+        run_start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < ops.size(); ++i) {
+            const BenchOp& op = ops[i];
+            if (op.is_cancel) continue;
+            auto t0 = std::chrono::steady_clock::now();
+            bool ok = client.submitOrderFast(i + 1,
+                                             static_cast<uint16_t>(op.symbol_idx + 1),
+                                             op.side, op.order_type,
+                                             op.quantity, op.price_cents);
+            auto t1 = std::chrono::steady_clock::now();
+            latencies_ns.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+            if (ok) ++submitted; else ++rejected;
+        }
+
+        if (!waitForDrain(exchange, submitted)) {
+            std::cerr << "Timed out waiting for queues to drain" << std::endl;
+        }
+        server.stop();
+    }
+
+    if (opts.shm_name.empty() && !waitForDrain(exchange, submitted)) {
+        std::cerr << "Timed out waiting for queues to drain" << std::endl;
+    }
+
+    auto run_end = std::chrono::steady_clock::now();
+    double elapsed_sec = std::chrono::duration<double>(run_end - run_start).count();
+    uint64_t processed = exchange.totalOrdersProcessed();
+
+    std::cout << "\nResults:" << std::endl;
+    std::cout << "  submitted: " << submitted << "  rejected: " << rejected
+              << "  processed: " << processed << std::endl;
+    std::cout << std::fixed << std::setprecision(0)
+              << "  throughput: " << (elapsed_sec > 0.0 ? static_cast<double>(submitted) / elapsed_sec : 0.0)
+              << " ops/sec (submit to fully drained, " << std::setprecision(3)
+              << elapsed_sec << "s)" << std::endl;
+    reportPercentiles(latencies_ns, "submit latency");
+
+    exchange.stop();
+    return rejected > submitted ? 1 : 0;
+}
@@ -932,10 +932,64 @@ void testOrderCancellation(TestSuite& suite) {
     // Test 12.2: Cancel non-existent order
     {
         std::string result = stock.cancelOrder("NONEXISTENT_ORDER");
-        suite.test("Cancel non-existent order handled", 
+        suite.test("Cancel non-existent order handled",
                    result.find("not found") != std::string::npos || result.find("rejected") != std::string::npos);
     }
 
+    // Test 12.3: Mass cancel pulls one user's orders and leaves others
+    {
+        Order buy1("MASS001", "USER_MC", "CANCEL", 0, 1, 100, Order::fromDouble(95.0), now);
+        Order buy2("MASS002", "USER_MC", "CANCEL", 0, 1, 100, Order::fromDouble(94.0), now);
+        Order sell1("MASS003", "USER_MC", "CANCEL", 1, 1, 100, Order::fromDouble(105.0), now);
+        Order other("MASS004", "USER_OTHER", "CANCEL", 0, 1, 100, Order::fromDouble(93.0), now);
+        stock.submitOrder(buy1);
+        stock.submitOrder(buy2);
+        stock.submitOrder(sell1);
+        stock.submitOrder(other);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        std::string result = stock.cancelAllForUser("USER_MC");
+        suite.test("Mass cancel submitted", result == "cancel all submitted");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        suite.test("Mass cancel hits user's buys", stock.getOrderStatus("MASS001").status == "cancelled");
+        suite.test("Mass cancel hits user's sells", stock.getOrderStatus("MASS003").status == "cancelled");
+        suite.test("Mass cancel leaves other users", stock.getOrderStatus("MASS004").status == "open");
+    }
+
+    // Test 12.4: Mass cancel for an unknown user is a no-op
+    {
+        std::string result = stock.cancelAllForUser("USER_NEVER_SEEN");
+        suite.test("Mass cancel unknown user handled",
+                   result.find("nothing to cancel") != std::string::npos);
+    }
+
+    // Test 12.5: Mass cancel after one of the user's resting orders filled.
+    // A fill deallocates the resting order, so it must also unlink it from
+    // the user's intrusive list or the mass cancel walks freed memory.
+    {
+        Order filled("FILL001", "USER_FC", "CANCEL", 0, 1, 100, Order::fromDouble(100.0), now);
+        Order resting("FILL002", "USER_FC", "CANCEL", 0, 1, 100, Order::fromDouble(90.0), now);
+        Order taker("FILL003", "USER_FC_CP", "CANCEL", 1, 1, 100, Order::fromDouble(100.0), now);
+        stock.submitOrder(filled);
+        stock.submitOrder(resting);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stock.submitOrder(taker); // Fills FILL001 completely
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        suite.test("Resting order filled before mass cancel",
+                   stock.getOrderStatus("FILL001").status == "filled");
+
+        std::string result = stock.cancelAllForUser("USER_FC");
+        suite.test("Mass cancel after fill submitted", result == "cancel all submitted");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        suite.test("Mass cancel after fill hits surviving order",
+                   stock.getOrderStatus("FILL002").status == "cancelled");
+        suite.test("Filled order stays filled after mass cancel",
+                   stock.getOrderStatus("FILL001").status == "filled");
+    }
+
     stock.stop();
 }
 